@@ -0,0 +1,33 @@
+#pragma once
+/* -------------------- Conteo de reservas --------------------
+ * Reemplaza el operator new global para contar reservas de memoria (lo usa
+ * --stats). Incluir una sola vez, desde main.cpp.
+ */
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace AllocStats {
+    inline size_t count = 0;
+    inline size_t bytes = 0;
+}
+
+namespace AllocStats {
+    // new y delete pasan por este par: así GCC no ve un free() sobre lo que
+    // devolvió operator new (-Wmismatched-new-delete) y queda claro que
+    // ambos usan el mismo reservador.
+    [[gnu::noinline]] static void* rawAlloc(size_t n) {
+        ++count;
+        bytes += n;
+        if (void* p = std::malloc(n ? n : 1)) return p;
+        throw std::bad_alloc();
+    }
+    [[gnu::noinline]] static void rawFree(void* p) noexcept { std::free(p); }
+}
+
+void* operator new(size_t n)   { return AllocStats::rawAlloc(n); }
+void* operator new[](size_t n) { return AllocStats::rawAlloc(n); }
+void  operator delete(void* p) noexcept           { AllocStats::rawFree(p); }
+void  operator delete(void* p, size_t) noexcept   { AllocStats::rawFree(p); }
+void  operator delete[](void* p) noexcept         { AllocStats::rawFree(p); }
+void  operator delete[](void* p, size_t) noexcept { AllocStats::rawFree(p); }
@@ -0,0 +1,124 @@
+#pragma once
+/* -------------------- Arena + AST --------------------
+ * Todos los nodos y las cadenas que guardan se piden a un Arena: reservas
+ * por bloques de 64 KB que avanzan un puntero y se liberan juntas cuando el
+ * Arena se destruye. Un nodo no tiene mapa ni vector propios: hasta dos
+ * propiedades en línea y los hijos como lista enlazada.
+ */
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+struct Arena {
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    ~Arena() { release(); }
+
+    void* alloc(size_t n, size_t align = alignof(std::max_align_t)) {
+        size_t pad = (align - reinterpret_cast<uintptr_t>(cur) % align) % align;
+        if (cur == nullptr || pad + n > left) {
+            grow(n + align);
+            pad = (align - reinterpret_cast<uintptr_t>(cur) % align) % align;
+        }
+        char* p = cur + pad;
+        cur  += pad + n;
+        left -= pad + n;
+        used += n;
+        return p;
+    }
+
+    // Solo para tipos que no necesitan destructor: el Arena no los llama
+    template<class T> T* make() {
+        static_assert(std::is_trivially_destructible<T>::value, "el Arena no llama destructores");
+        return new (alloc(sizeof(T), alignof(T))) T();
+    }
+
+    // Copia el texto al Arena; la vista vive lo mismo que el Arena
+    std::string_view str(std::string_view s) {
+        if (s.empty()) return std::string_view();
+        char* p = static_cast<char*>(alloc(s.size(), 1));
+        std::memcpy(p, s.data(), s.size());
+        return std::string_view(p, s.size());
+    }
+
+    void release() {
+        for (char* b : blocks) ::operator delete(b);
+        blocks.clear();
+        cur = nullptr; left = 0; used = 0;
+    }
+
+    size_t blockCount() const { return blocks.size(); }
+    size_t bytesUsed() const { return used; }
+
+private:
+    std::vector<char*> blocks;
+    char*  cur  = nullptr;
+    size_t left = 0;
+    size_t used = 0;
+
+    void grow(size_t atLeast) {
+        size_t size = atLeast > BLOCK_SIZE ? atLeast : BLOCK_SIZE;
+        char* b = static_cast<char*>(::operator new(size));
+        blocks.push_back(b);
+        cur = b; left = size;
+    }
+};
+
+/* -------------------- AST Node -------------------- */
+struct Prop {
+    const char*      key;     // siempre un literal ("name", "op", ...)
+    std::string_view value;   // literal o cadena copiada al Arena
+};
+
+struct AST {
+    static constexpr int MAX_PROPS = 2;   // Class (name, extends) y Attribute (name, type)
+
+    const char* nodeType = "";
+    Prop     props[MAX_PROPS] = {};
+    uint8_t  nprops = 0;
+    uint32_t nchildren = 0;
+    AST* first = nullptr;   // primer hijo
+    AST* last  = nullptr;   // último hijo (para agregar en O(1))
+    AST* next  = nullptr;   // siguiente hermano
+    int line = 0, col = 0;
+
+    void set(const char* key, std::string_view value) {
+        for (int i = 0; i < nprops; ++i) {
+            if (std::strcmp(props[i].key, key) == 0) { props[i].value = value; return; }
+        }
+        if (nprops == MAX_PROPS) throw std::logic_error("AST: demasiadas propiedades en un nodo");
+        props[nprops++] = Prop{key, value};
+    }
+
+    std::string_view get(const char* key) const {
+        for (int i = 0; i < nprops; ++i) {
+            if (std::strcmp(props[i].key, key) == 0) return props[i].value;
+        }
+        return std::string_view();
+    }
+
+    void add(AST* child) {
+        if (!child) return;
+        if (last) last->next = child; else first = child;
+        last = child;
+        ++nchildren;
+    }
+
+    // Pone 'neu' en el lugar del hijo 'old' (re-parseo incremental)
+    void replace(AST* old, AST* neu) {
+        neu->next = old->next;
+        if (first == old) first = neu;
+        else for (AST* c = first; c; c = c->next) {
+            if (c->next == old) { c->next = neu; break; }
+        }
+        if (last == old) last = neu;
+    }
+};
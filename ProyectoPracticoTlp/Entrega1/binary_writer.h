@@ -0,0 +1,81 @@
+#pragma once
+/* -------------------- Escritura del AST binario (.astb) --------------------
+ * El formato está en Entrega3/src/interpreter/ast_binary.h, que también usa
+ * el intérprete para leerlo. Los nodos se numeran por niveles (los hijos de
+ * cada nodo quedan contiguos) y cada texto distinto (tipos, claves, valores)
+ * entra una sola vez a la tabla de cadenas.
+ */
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ast_arena.h"
+#include "../Entrega3/src/interpreter/ast_binary.h"
+
+struct BinaryWriter {
+    void document(const AST* root) {
+        nodes.clear(); chars.clear(); offsets.clear(); ids.clear();
+        std::vector<const AST*> order;   // order[i] es el nodo i del archivo
+        order.push_back(root);
+        for (size_t i = 0; i < order.size(); ++i) {
+            const AST* n = order[i];
+            AstBin::Node b = {};
+            b.type = intern(n->nodeType);
+            b.nprops = n->nprops;
+            for (int p = 0; p < n->nprops; ++p) {
+                b.key[p] = intern(n->props[p].key);
+                b.value[p] = intern(n->props[p].value);
+            }
+            b.firstChild = n->first ? (uint32_t)order.size() : 0;
+            b.childCount = n->nchildren;
+            b.line = n->line; b.col = n->col;
+            for (const AST* c = n->first; c; c = c->next) order.push_back(c);
+            nodes.push_back(b);
+        }
+        offsets.push_back((uint32_t)chars.size());
+        ids.clear();   // las claves apuntan al árbol, que puede no sobrevivir al writer
+    }
+
+    size_t size() const {
+        return sizeof(AstBin::Header) + nodes.size() * sizeof(AstBin::Node)
+             + offsets.size() * sizeof(uint32_t) + chars.size();
+    }
+
+    bool save(const char* path) const {
+        AstBin::Header h = {};
+        AstBin::setMagic(h);
+        h.version = AstBin::VERSION;
+        h.nodeCount = (uint32_t)nodes.size();
+        h.stringCount = (uint32_t)offsets.size() - 1;
+        h.nodesOffset = sizeof(h);
+        h.offsetsOffset = h.nodesOffset + (uint32_t)(nodes.size() * sizeof(AstBin::Node));
+        h.charsOffset = h.offsetsOffset + (uint32_t)(offsets.size() * sizeof(uint32_t));
+        h.fileSize = (uint32_t)size();
+        FILE* f = std::fopen(path, "wb");
+        if (!f) return false;
+        bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1
+               && std::fwrite(nodes.data(), sizeof(AstBin::Node), nodes.size(), f) == nodes.size()
+               && std::fwrite(offsets.data(), sizeof(uint32_t), offsets.size(), f) == offsets.size()
+               && std::fwrite(chars.data(), 1, chars.size(), f) == chars.size();
+        return (std::fclose(f) == 0) && ok;
+    }
+
+private:
+    std::vector<AstBin::Node> nodes;
+    std::vector<uint32_t> offsets;   // uno por cadena más el final
+    std::string chars;               // cadenas terminadas en '\0'
+    std::unordered_map<std::string_view, uint32_t> ids;
+
+    uint32_t intern(std::string_view s) {
+        auto it = ids.find(s);
+        if (it != ids.end()) return it->second;
+        uint32_t id = (uint32_t)offsets.size();
+        offsets.push_back((uint32_t)chars.size());
+        chars.append(s.data(), s.size());
+        chars.push_back('\0');
+        ids.emplace(s, id);
+        return id;
+    }
+};
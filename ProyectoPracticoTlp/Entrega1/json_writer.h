@@ -0,0 +1,169 @@
+#pragma once
+/* -------------------- Escritura del AST en JSON --------------------
+ * Todo el documento se arma en un solo búfer que crece y se escribe al
+ * disco con una llamada. Antes de cada nodo se reserva lo máximo que puede
+ * ocupar, y después se copia con un puntero sin más comprobaciones (la
+ * sangría con memset, sin crear un string por nodo). Los valores se
+ * escapan según JSON. El modo legible produce el mismo
+ * texto que el writeJSON anterior; el compacto no lleva espacios ni saltos
+ * de línea.
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "ast_arena.h"
+
+struct JsonWriter {
+    bool compact;
+
+    explicit JsonWriter(bool compactMode = false): compact(compactMode) {}
+
+    // El documento completo, terminado en '\n' como antes
+    void document(const AST* root) {
+        node(root, 0);
+        ensure(1);
+        buf[len++] = '\n';
+    }
+
+    std::string_view view() const { return std::string_view(buf.data(), len); }
+    size_t size() const { return len; }
+    void clear() { len = 0; }
+    void reserve(size_t n) { if (n > buf.size()) buf.resize(n); }
+
+    bool save(const char* path) const {
+        FILE* f = std::fopen(path, "wb");
+        if (!f) return false;
+        bool ok = std::fwrite(buf.data(), 1, len, f) == len;
+        return (std::fclose(f) == 0) && ok;
+    }
+
+private:
+    std::string buf;   // buf.size() es la capacidad; lo escrito es [0, len)
+    size_t len = 0;
+
+    void ensure(size_t n) {
+        if (len + n > buf.size()) buf.resize(std::max(buf.size() * 2, len + n + 4096));
+    }
+
+    // Lo más que puede ocupar la cabecera y las propiedades de n (un byte
+    // escapado ocupa hasta 6 con \u00XX), sin contar los hijos
+    static size_t bound(const AST* n, int indent) {
+        size_t b = 8 * (size_t)indent + 96 + std::strlen(n->nodeType);
+        for (int i = 0; i < n->nprops; ++i)
+            b += (size_t)indent + 16 + std::strlen(n->props[i].key) + 6 * n->props[i].value.size();
+        return b;
+    }
+
+    template<size_t N> static char* lit(char* w, const char (&s)[N]) {
+        std::memcpy(w, s, N - 1);
+        return w + N - 1;
+    }
+
+    static char* pad(char* w, int n) {
+        std::memset(w, ' ', n);
+        return w + n;
+    }
+
+    // Cadena JSON entre comillas con ", \ y los caracteres de control escapados
+    static char* str(char* w, std::string_view s) {
+        *w++ = '"';
+        size_t run = 0;   // comienzo del tramo que no necesita escape
+        for (size_t i = 0; i < s.size(); ++i) {
+            unsigned char c = (unsigned char)s[i];
+            if (c >= 0x20 && c != '"' && c != '\\') continue;
+            std::memcpy(w, s.data() + run, i - run);
+            w += i - run;
+            run = i + 1;
+            *w++ = '\\';
+            switch (c) {
+                case '"':  *w++ = '"'; break;
+                case '\\': *w++ = '\\'; break;
+                case '\n': *w++ = 'n'; break;
+                case '\t': *w++ = 't'; break;
+                case '\r': *w++ = 'r'; break;
+                case '\b': *w++ = 'b'; break;
+                case '\f': *w++ = 'f'; break;
+                default: {
+                    static const char hex[] = "0123456789abcdef";
+                    *w++ = 'u'; *w++ = '0'; *w++ = '0';
+                    *w++ = hex[c >> 4]; *w++ = hex[c & 15];
+                }
+            }
+        }
+        std::memcpy(w, s.data() + run, s.size() - run);
+        w += s.size() - run;
+        *w++ = '"';
+        return w;
+    }
+
+    void node(const AST* n, int indent) {
+        ensure(bound(n, indent));
+        char* w = &buf[len];
+        if (compact) {
+            w = lit(w, "{\"node\":");
+            w = str(w, n->nodeType);
+            if (n->nprops > 0) {
+                w = lit(w, ",\"props\":{");
+                for (int i = 0; i < n->nprops; ++i) {
+                    if (i > 0) *w++ = ',';
+                    w = str(w, n->props[i].key);
+                    *w++ = ':';
+                    w = str(w, n->props[i].value);
+                }
+                *w++ = '}';
+            }
+            if (!n->first) {
+                *w++ = '}';
+                len = w - buf.data();
+                return;
+            }
+            w = lit(w, ",\"children\":[");
+            len = w - buf.data();
+            for (const AST* c = n->first; c; c = c->next) {
+                node(c, 0);
+                ensure(2);
+                if (c->next) buf[len++] = ',';
+            }
+            buf[len++] = ']';
+            buf[len++] = '}';
+            return;
+        }
+
+        w = pad(w, indent); w = lit(w, "{\n");
+        w = pad(w, indent); w = lit(w, "  \"node\": "); w = str(w, n->nodeType);
+        if (n->nprops > 0) {
+            w = lit(w, ",\n");
+            w = pad(w, indent); w = lit(w, "  \"props\": {\n");
+            for (int i = 0; i < n->nprops; ++i) {
+                if (i > 0) w = lit(w, ",\n");
+                w = pad(w, indent + 4); w = str(w, n->props[i].key);
+                w = lit(w, ": ");       w = str(w, n->props[i].value);
+            }
+            *w++ = '\n';
+            w = pad(w, indent); w = lit(w, "  }");
+        }
+        if (!n->first) {
+            *w++ = '\n';
+            w = pad(w, indent); *w++ = '}';
+            len = w - buf.data();
+            return;
+        }
+        w = lit(w, ",\n");
+        w = pad(w, indent); w = lit(w, "  \"children\": [\n");
+        len = w - buf.data();
+        for (const AST* c = n->first; c; c = c->next) {
+            node(c, indent + 4);
+            ensure(2);
+            if (c->next) buf[len++] = ',';
+            buf[len++] = '\n';
+        }
+        ensure(2 * (size_t)indent + 8);
+        w = &buf[len];
+        w = pad(w, indent); w = lit(w, "  ]\n");
+        w = pad(w, indent); *w++ = '}';
+        len = w - buf.data();
+    }
+};
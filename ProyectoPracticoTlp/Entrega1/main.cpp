@@ -1,4 +1,16 @@
+// Compilar: g++ -std=gnu++17 -O2 main.cpp -o main   (--stats, --gen, --bench-*, --compact, --bin, --no-mmap: ver main())
+//           agregar -mavx2 para escanear de a 32 bytes, -DSCAN_SCALAR para la version sin SIMD,
+//           -DJSON_CHECK para que --bench-json verifique la salida con json.hpp
 #include <bits/stdc++.h>
+#include "ast_arena.h"
+#include "alloc_stats.h"
+#include "mapped_file.h"
+#include "simd_scan.h"
+#include "json_writer.h"
+#include "binary_writer.h"
+#ifdef JSON_CHECK
+#include "../Entrega3/third_party/json.hpp"   // solo para verificar --bench-json
+#endif
 using namespace std;
 
 /* -------------------- Tokens & Lexer  -------------------- */
@@ -16,11 +28,14 @@ enum class TokenType {
     END_OF_FILE, UNKNOWN
 };
 
+// El lexema apunta dentro de la fuente (o a un literal): el token no es dueño
+// del texto, la fuente debe vivir mientras se usen los tokens
 struct Token {
     TokenType type;
-    string lexeme;
+    string_view lexeme;
     int line;
     int col;
+    bool escaped = false;   // STRING_LITERAL con escapes: lexeme es el texto crudo
 };
 
 string tokenTypeName(TokenType t) {
@@ -71,231 +86,343 @@ string tokenTypeName(TokenType t) {
     }
 }
 
-struct Lexer {
-    string src;
-    size_t i = 0;
-    int line = 1, col = 1;
-    vector<Token> tokens;
-    Lexer(const string &s): src(s) {}
-
-    char peek() { return (i < src.size() ? src[i] : '\0'); }
-    char peekNext() { return (i+1 < src.size() ? src[i+1] : '\0'); }
-    char get() {
-        if (i >= src.size()) return '\0';
-        char c = src[i++];
-        if (c == '\n') { line++; col = 1; } else col++;
-        return c;
-    }
-    static bool isIdentStart(char c) {
-        return (isalpha((unsigned char)c) || c == '_' || (unsigned char)c >= 128);
+/* -------------------- Palabras clave (hash perfecto) --------------------
+ * Las 16 palabras clave caen en celdas distintas de una tabla de 32 usando
+ * solo longitud, primera y última letra (en minúscula). Basta una
+ * comparación sin distinguir mayúsculas para confirmar: no hay copia en
+ * minúsculas del identificador.
+ */
+struct Keyword {
+    string_view word;   // en minúscula
+    TokenType type;
+};
+
+constexpr Keyword KEYWORDS[] = {
+    {"class", TokenType::CLASS}, {"extends", TokenType::EXTENDS}, {"int", TokenType::INT},
+    {"string", TokenType::STRING}, {"bool", TokenType::BOOL}, {"method", TokenType::METHOD},
+    {"methodmain", TokenType::METHODMAIN}, {"print", TokenType::PRINT}, {"if", TokenType::IF},
+    {"else", TokenType::ELSE}, {"while", TokenType::WHILE}, {"for", TokenType::FOR},
+    {"return", TokenType::RETURN}, {"true", TokenType::BOOLEAN_LITERAL},
+    {"false", TokenType::BOOLEAN_LITERAL}, {"null", TokenType::NULL_LITERAL},
+};
+
+constexpr size_t KEYWORD_SLOTS = 32;
+
+// c | 0x20 pasa A-Z a a-z; ningún otro byte cae en a-z, así que comparar
+// contra una letra minúscula no da falsos positivos
+constexpr unsigned keywordHash(size_t len, char first, char last) {
+    return (unsigned)(len + ((unsigned char)first | 0x20) + ((unsigned char)last | 0x20) * 21) & (KEYWORD_SLOTS - 1);
+}
+
+struct KeywordTable {
+    int8_t slot[KEYWORD_SLOTS];   // índice en KEYWORDS o -1
+    bool perfect;
+    constexpr KeywordTable(): slot{}, perfect(true) {
+        for (auto &s : slot) s = -1;
+        for (size_t k = 0; k < size(KEYWORDS); ++k) {
+            string_view w = KEYWORDS[k].word;
+            unsigned h = keywordHash(w.size(), w.front(), w.back());
+            if (slot[h] != -1) perfect = false;
+            slot[h] = (int8_t)k;
+        }
     }
-    static bool isIdentChar(char c) {
-        return isalnum((unsigned char)c) || c == '_' || (unsigned char)c >= 128;
+};
+
+constexpr KeywordTable KEYWORD_TABLE;
+static_assert(KEYWORD_TABLE.perfect, "colision en la tabla de palabras clave: ajustar keywordHash");
+
+// Devuelve IDENT si 'id' no es palabra clave (sin distinguir mayúsculas)
+inline const Keyword* findKeyword(string_view id) {
+    if (id.size() < 2 || id.size() > 10) return nullptr;
+    int k = KEYWORD_TABLE.slot[keywordHash(id.size(), id.front(), id.back())];
+    if (k < 0) return nullptr;
+    const Keyword &kw = KEYWORDS[k];
+    if (kw.word.size() != id.size()) return nullptr;
+    for (size_t j = 0; j < id.size(); ++j) {
+        if (((unsigned char)id[j] | 0x20) != (unsigned char)kw.word[j]) return nullptr;
     }
+    return &kw;
+}
 
-    void addToken(TokenType t, const string &lex) {
-        int startCol = max(1, col - (int)lex.size());
-        tokens.push_back({t, lex, line, startCol});
+/* -------------------- Lexer --------------------
+ * Recorre la fuente con punteros y entrega un token por llamada a next();
+ * los tokens apuntan dentro de ella (normalmente el archivo mapeado) y
+ * ningún token reserva memoria. Los literales de cadena guardan el texto
+ * crudo entre comillas; si tienen escapes, 'escaped' lo indica y unescape()
+ * los resuelve al copiarlos. Al llegar al final next() repite END_OF_FILE.
+ */
+struct Lexer {
+    const char* const begin;
+    const char* const end;
+    const char* p;
+    Scan::LinePos pos;   // línea actual; la columna es p - pos.lineStart + 1
+    bool keepComments;   // false: los COMMENT se descartan aquí y el parser no los ve
+    size_t count = 0;    // tokens entregados
+    explicit Lexer(string_view s, bool comments = true)
+        : begin(s.data()), end(s.data() + s.size()), p(begin), pos{1, begin}, keepComments(comments) {}
+    // Para lexear un trozo de un archivo: 'start' da la línea y el comienzo
+    // de línea que corresponden a s.data()
+    Lexer(string_view s, Scan::LinePos start, bool comments)
+        : begin(s.data()), end(s.data() + s.size()), p(begin), pos(start), keepComments(comments) {}
+
+    int col() const { return (int)(p - pos.lineStart) + 1; }
+    char peek() const { return (p < end ? *p : '\0'); }
+    char peekNext() const { return (p + 1 < end ? p[1] : '\0'); }
+
+    static bool isIdentStart(char c) {
+        return (isalpha((unsigned char)c) || c == '_' || (unsigned char)c >= 128);
     }
 
-    void skipWhitespace() {
-        while (true) {
-            char c = peek();
-            if (c == ' ' || c == '\t' || c == '\r' || c == '\n') get();
-            else break;
-        }
+    // Misma columna que daba la versión anterior: la del final del token
+    // menos la longitud del lexema (len), como mínimo 1
+    Token make(TokenType t, string_view lex, size_t len, bool escaped = false) {
+        ++count;
+        return Token{t, lex, pos.line, max(1, col() - (int)len), escaped};
     }
+    Token make(TokenType t, string_view lex) { return make(t, lex, lex.size()); }
 
-    void tokenize() {
+    // Los bucles de espacios, comentarios, cadenas e identificadores están en
+    // simd_scan.h; cada búsqueda actualiza pos con las líneas que salta
+    Token next() {
         while (true) {
-            skipWhitespace();
+            p = Scan::skipSpaces(p, end, pos);
             char c = peek();
-            if (c == '\0') { addToken(TokenType::END_OF_FILE, ""); break; }
+            if (c == '\0') return make(TokenType::END_OF_FILE, string_view());
+            const char* start = p;
 
             // comments
             if (c == '/') {
                 if (peekNext() == '/') {
-                    get(); get();
-                    string com;
-                    while (peek() != '\0' && peek() != '\n') com.push_back(get());
-                    addToken(TokenType::COMMENT, com);
-                    continue;
+                    const char* q = Scan::findLineEnd(p + 2, end);
+                    p = q;
+                    if (!keepComments) continue;
+                    return make(TokenType::COMMENT, string_view(start + 2, q - start - 2));
                 } else if (peekNext() == '*') {
-                    get(); get();
-                    string com;
-                    while (!(peek() == '*' && peekNext() == '/') && peek() != '\0') com.push_back(get());
-                    if (peek() == '*' && peekNext() == '/') { get(); get(); }
-                    addToken(TokenType::COMMENT, com);
-                    continue;
+                    const char* q = Scan::findBlockEnd(p + 2, end, pos);
+                    string_view com(start + 2, q - start - 2);
+                    if (q < end && *q == '*') q += 2;
+                    p = q;
+                    if (!keepComments) continue;
+                    return make(TokenType::COMMENT, com);
                 }
             }
 
             // string literal
             if (c == '"') {
-                get();
-                string val;
-                while (peek() != '\0' && peek() != '"') {
-                    char ch = get();
-                    if (ch == '\\' && peek()!='\0') {
-                        char esc = get();
-                        if (esc == 'n') val.push_back('\n');
-                        else if (esc == 't') val.push_back('\t');
-                        else val.push_back(esc);
-                    } else val.push_back(ch);
+                const char* q = Scan::findStringStop(p + 1, end, pos);
+                size_t escapes = 0;
+                while (q < end && *q == '\\') {
+                    if (q + 1 < end && q[1] != '\0') {
+                        ++escapes;
+                        if (q[1] == '\n') { ++pos.line; pos.lineStart = q + 2; }
+                        q += 2;
+                    } else ++q;   // '\\' al final: queda como texto
+                    q = Scan::findStringStop(q, end, pos);
                 }
-                if (peek() == '"') get();
-                addToken(TokenType::STRING_LITERAL, val);
-                continue;
+                string_view raw(start + 1, q - start - 1);
+                if (q < end && *q == '"') ++q;
+                p = q;
+                return make(TokenType::STRING_LITERAL, raw, raw.size() - escapes, escapes > 0);
             }
 
             // number
             if (isdigit((unsigned char)c)) {
-                string num;
-                while (isdigit((unsigned char)peek())) num.push_back(get());
-                addToken(TokenType::NUMBER, num);
-                continue;
+                while (p < end && isdigit((unsigned char)*p)) ++p;
+                return make(TokenType::NUMBER, string_view(start, p - start));
             }
 
             // identifiers and keywords
             if (isIdentStart(c)) {
-                string id;
-                while (isIdentChar(peek())) id.push_back(get());
-                string lower = id; for (auto &ch : lower) ch = tolower((unsigned char)ch);
-                if (lower == "class") addToken(TokenType::CLASS, id);
-                else if (lower == "extends") addToken(TokenType::EXTENDS, id);
-                else if (lower == "int") addToken(TokenType::INT, id);
-                else if (lower == "string") addToken(TokenType::STRING, id);
-                else if (lower == "bool") addToken(TokenType::BOOL, id);
-                else if (lower == "method") addToken(TokenType::METHOD, id);
-                else if (lower == "methodmain") addToken(TokenType::METHODMAIN, id);
-                else if (lower == "print") addToken(TokenType::PRINT, id);
-                else if (lower == "if") addToken(TokenType::IF, id);
-                else if (lower == "else") addToken(TokenType::ELSE, id);
-                else if (lower == "while") addToken(TokenType::WHILE, id);
-                else if (lower == "for") addToken(TokenType::FOR, id);
-                else if (lower == "return") addToken(TokenType::RETURN, id);
-                else if (lower == "true" || lower == "false") addToken(TokenType::BOOLEAN_LITERAL, lower);
-                else if (lower == "null") addToken(TokenType::NULL_LITERAL, lower);
-                else addToken(TokenType::IDENT, id);
-                continue;
+                p = Scan::identEnd(p, end);
+                string_view id(start, p - start);
+                const Keyword* kw = findKeyword(id);
+                if (!kw) return make(TokenType::IDENT, id);
+                // true/false/null se guardan en minúscula, el resto tal como se escribió
+                if (kw->type == TokenType::BOOLEAN_LITERAL || kw->type == TokenType::NULL_LITERAL)
+                    return make(kw->type, kw->word);
+                return make(kw->type, id);
             }
 
             // multi-char and single char ops
-            if (c == '=') {
-                if (peekNext() == '=') { get(); get(); addToken(TokenType::EQEQ, "=="); }
-                else { get(); addToken(TokenType::EQUAL, "="); }
-                continue;
+            if (c == '=' || c == '!' || c == '<' || c == '>') {
+                bool eq = (peekNext() == '=');
+                TokenType t = c == '=' ? (eq ? TokenType::EQEQ : TokenType::EQUAL)
+                            : c == '!' ? (eq ? TokenType::NOTEQ : TokenType::NOT)
+                            : c == '<' ? (eq ? TokenType::LE : TokenType::LT)
+                            :            (eq ? TokenType::GE : TokenType::GT);
+                p += eq ? 2 : 1;
+                return make(t, string_view(start, p - start));
             }
-            if (c == '!') {
-                if (peekNext() == '=') { get(); get(); addToken(TokenType::NOTEQ, "!="); }
-                else { get(); addToken(TokenType::NOT, "!"); }
-                continue;
-            }
-            if (c == '<') {
-                if (peekNext() == '=') { get(); get(); addToken(TokenType::LE, "<="); }
-                else { get(); addToken(TokenType::LT, "<"); }
-                continue;
+            if ((c == '&' || c == '|') && peekNext() == c) {
+                p += 2;
+                return make(c == '&' ? TokenType::ANDAND : TokenType::OROR, string_view(start, 2));
             }
-            if (c == '>') {
-                if (peekNext() == '=') { get(); get(); addToken(TokenType::GE, ">="); }
-                else { get(); addToken(TokenType::GT, ">"); }
-                continue;
-            }
-            if (c == '&' && peekNext() == '&') { get(); get(); addToken(TokenType::ANDAND, "&&"); continue; }
-            if (c == '|' && peekNext() == '|') { get(); get(); addToken(TokenType::OROR, "||"); continue; }
 
+            TokenType single;
             switch (c) {
-                case '{': get(); addToken(TokenType::LBRACE, "{"); break;
-                case '}': get(); addToken(TokenType::RBRACE, "}"); break;
-                case '[': get(); addToken(TokenType::LBRACKET, "["); break;
-                case ']': get(); addToken(TokenType::RBRACKET, "]"); break;
-                case '(': get(); addToken(TokenType::LPAREN, "("); break;
-                case ')': get(); addToken(TokenType::RPAREN, ")"); break;
-                case ';': get(); addToken(TokenType::SEMICOLON, ";"); break;
-                case ',': get(); addToken(TokenType::COMMA, ","); break;
-                case '+': get(); addToken(TokenType::PLUS, "+"); break;
-                case '-': get(); addToken(TokenType::MINUS, "-"); break;
-                case '*': get(); addToken(TokenType::STAR, "*"); break;
+                case '{': single = TokenType::LBRACE; break;
+                case '}': single = TokenType::RBRACE; break;
+                case '[': single = TokenType::LBRACKET; break;
+                case ']': single = TokenType::RBRACKET; break;
+                case '(': single = TokenType::LPAREN; break;
+                case ')': single = TokenType::RPAREN; break;
+                case ';': single = TokenType::SEMICOLON; break;
+                case ',': single = TokenType::COMMA; break;
+                case '+': single = TokenType::PLUS; break;
+                case '-': single = TokenType::MINUS; break;
+                case '*': single = TokenType::STAR; break;
                 // ✅ FIX: quitar get() extra en el token SLASH
-                case '/': get(); addToken(TokenType::SLASH, "/"); break;
-                default: {
-                    string s; s.push_back(get());
-                    addToken(TokenType::UNKNOWN, s);
-                    break;
-                }
+                case '/': single = TokenType::SLASH; break;
+                default:  single = TokenType::UNKNOWN; break;
             }
+            ++p;
+            return make(single, string_view(start, 1));
         }
     }
 };
 
-/* -------------------- AST Node -------------------- */
-struct AST {
-    string nodeType;
-    unordered_map<string,string> kv;
-    vector<AST*> children;
-    int line = 0, col = 0;
-    AST(const string &t=""): nodeType(t) {}
+// Resuelve los escapes de un literal de cadena (\n, \t, \x -> x)
+template<class Out>
+void unescape(string_view raw, Out &&push) {
+    for (size_t k = 0; k < raw.size(); ++k) {
+        char ch = raw[k];
+        if (ch == '\\' && k + 1 < raw.size()) {
+            char esc = raw[++k];
+            push(esc == 'n' ? '\n' : (esc == 't' ? '\t' : esc));
+        } else push(ch);
+    }
+}
+
+/* -------------------- Flujo de tokens --------------------
+ * Ventana de anticipación sobre el Lexer: el parser pide los tokens a
+ * medida que avanza, así que la memoria no crece con el tamaño del archivo.
+ */
+struct TokenStream {
+    static constexpr size_t LOOKAHEAD = 4;   // peek(k) admite k < LOOKAHEAD
+
+    Lexer &lex;
+    Token ring[LOOKAHEAD] = {};
+    size_t head = 0, filled = 0;
+    const char* consumedEnd = nullptr;   // fin en la fuente del último token consumido
+    explicit TokenStream(Lexer &l): lex(l) {}
+
+    const Token& peek(size_t k = 0) {
+        while (filled <= k) { ring[(head + filled) % LOOKAHEAD] = lex.next(); ++filled; }
+        return ring[(head + k) % LOOKAHEAD];
+    }
+    void advance() {
+        const Token &t = peek();
+        consumedEnd = t.lexeme.data() + t.lexeme.size();
+        head = (head + 1) % LOOKAHEAD;
+        --filled;
+    }
 };
 
+
 /* -------------------- Parser (recursive descent) -------------------- */
 
 struct Parser {
-    vector<Token> &tokens;
-    size_t idx = 0;
-    Parser(vector<Token> &toks): tokens(toks) {}
+    TokenStream &ts;
+    Arena &arena;
+    size_t nodeCount = 0;
+    bool quiet = false;   // sin mensajes en cerr (intentos del re-parseo incremental)
+    Parser(TokenStream &s, Arena &a): ts(s), arena(a) {}
+
+    // Si 'spans' no es nulo, parseProgram y parseClass anotan dónde empieza y
+    // termina en la fuente cada Class, Method y methodMain. Los métodos de
+    // una clase quedan antes que la clase (member = true).
+    struct Span {
+        AST* node;
+        const char* begin;
+        const char* end;
+        int line;
+        bool member;
+    };
+    vector<Span>* spans = nullptr;
+
+    ostream& err() {
+        static ostream nowhere(nullptr);
+        return quiet ? nowhere : cerr;
+    }
 
-    Token cur() { return (idx < tokens.size() ? tokens[idx] : Token{TokenType::END_OF_FILE,"",0,0}); }
+    AST* newNode(const char* type) {
+        AST* n = arena.make<AST>();
+        n->nodeType = type;
+        ++nodeCount;
+        return n;
+    }
+    // Los lexemas se copian al Arena: el árbol no depende de la fuente ni de
+    // los tokens. Los literales con escapes se resuelven en la copia.
+    string_view text(const Token &t) {
+        if (!t.escaped) return arena.str(t.lexeme);
+        char* out = static_cast<char*>(arena.alloc(t.lexeme.size(), 1));
+        size_t n = 0;
+        unescape(t.lexeme, [&](char ch) { out[n++] = ch; });
+        return string_view(out, n);
+    }
+
+    // La referencia vale hasta el próximo advance(): quien la necesite después, la copia
+    const Token& cur() { return ts.peek(); }
     bool match(TokenType tt) {
-        if (cur().type == tt) { idx++; return true; }
+        if (cur().type == tt) { ts.advance(); return true; }
         return false;
     }
-    bool expect(TokenType tt, const string &errMsg) {
+    bool expect(TokenType tt, const char* errMsg) {
         if (match(tt)) return true;
         Token c = cur();
-        cerr << "Error sintaxis (esperado " << tokenTypeName(tt) << ") en linea " << c.line << " col " << c.col << ". " << errMsg << "\n";
+        err() << "Error sintaxis (esperado " << tokenTypeName(tt) << ") en linea " << c.line << " col " << c.col << ". " << errMsg << "\n";
         throw runtime_error("Parse error");
     }
 
     // program = { class } , methodMain ;
     AST* parseProgram(){
-        AST* root = new AST("Program");
+        AST* root = newNode("Program");
         while (cur().type == TokenType::CLASS) {
-            root->children.push_back(parseClass());
+            Token start = cur();
+            AST* c = parseClass();
+            root->add(c);
+            if (spans) spans->push_back({c, start.lexeme.data(), ts.consumedEnd, start.line, false});
         }
         if (cur().type == TokenType::METHODMAIN) {
-            root->children.push_back(parseMethodMain());
+            Token start = cur();
+            AST* mm = parseMethodMain();
+            root->add(mm);
+            if (spans) spans->push_back({mm, start.lexeme.data(), ts.consumedEnd, start.line, false});
         } else {
             Token c = cur();
-            cerr << "Error: falta methodMain al final. Linea " << c.line << " col " << c.col << "\n";
+            err() << "Error: falta methodMain al final. Linea " << c.line << " col " << c.col << "\n";
             throw runtime_error("Parse error");
         }
         return root;
     }
      // class = "Class", identificador, [ "extends", identificador ], "{", { miembro }, "}" ;
     AST* parseClass(){
-        Token tclass = cur(); expect(TokenType::CLASS, "Se esperaba 'Class'");
+        expect(TokenType::CLASS, "Se esperaba 'Class'");
         Token name = cur(); expect(TokenType::IDENT, "Nombre de clase esperado");
-        AST* node = new AST("Class"); node->kv["name"] = name.lexeme; node->line = name.line; node->col = name.col;
+        AST* node = newNode("Class"); node->set("name", text(name)); node->line = name.line; node->col = name.col;
         if (cur().type == TokenType::EXTENDS) {
             match(TokenType::EXTENDS);
             Token p = cur(); expect(TokenType::IDENT, "Identificador despues de extends esperado");
-            node->kv["extends"] = p.lexeme;
+            node->set("extends", text(p));
         }
         expect(TokenType::LBRACE, "Se esperaba '{' para iniciar clase");
         while (cur().type != TokenType::RBRACE && cur().type != TokenType::END_OF_FILE) {
             if (cur().type == TokenType::INT || cur().type == TokenType::STRING || cur().type == TokenType::BOOL) {
-                node->children.push_back(parseAttribute());
+                node->add(parseAttribute());
                 continue;
             } else if (cur().type == TokenType::METHOD) {
-                node->children.push_back(parseMethod());
+                Token start = cur();
+                AST* m = parseMethod();
+                node->add(m);
+                if (spans) spans->push_back({m, start.lexeme.data(), ts.consumedEnd, start.line, true});
                 continue;
             } else if (cur().type == TokenType::COMMENT) {
-                idx++;
+                ts.advance();
                 continue;
             } else {
                 
                 Token c = cur();
-                cerr << "Error: miembro inesperado en clase '"<< name.lexeme <<"' linea " << c.line << " col " << c.col << "\n";
+                err() << "Error: miembro inesperado en clase '"<< name.lexeme <<"' linea " << c.line << " col " << c.col << "\n";
                 throw runtime_error("Parse error");
             }
         }
@@ -303,45 +430,45 @@ struct Parser {
         return node;
     }
     /*AST* parseAttribute(){
-        Token tipoTok = cur(); idx++;
+        Token tipoTok = cur(); ts.advance();
         string tipoLex = tokenTypeName(tipoTok.type); 
         Token name = cur(); expect(TokenType::IDENT, "Nombre de atributo esperado");
-        AST* a = new AST("Attribute");
-        a->kv["name"] = name.lexeme;
-        a->kv["type"] = (tipoLex=="STRING" ? "string" : (tipoLex=="INT" ? "int" : (tipoLex=="BOOL"? "bool": tipoLex)));
+        AST* a = newNode("Attribute");
+        a->set("name", text(name));
+        a->set("type", text(tipoLex=="STRING" ? "string" : (tipoLex=="INT" ? "int" : (tipoLex=="BOOL"? "bool": tipoLex))));
         a->line = name.line; a->col = name.col;
         if (match(TokenType::EQUAL)) {
             AST* expr = parseExpressionNode();
             
-            AST* init = new AST("Init");
-            init->kv["expr_type"] = expr->nodeType;
-            init->children.push_back(expr);
-            a->children.push_back(init);
+            AST* init = newNode("Init");
+            init->set("expr_type", expr->nodeType);
+            init->add(expr);
+            a->add(init);
         }
         expect(TokenType::SEMICOLON, "Falta ';' despues del atributo");
         return a;
     }*/
     AST* parseMethod(){
-        Token mt = cur(); expect(TokenType::METHOD, "Se esperaba 'method'");
+        expect(TokenType::METHOD, "Se esperaba 'method'");
         Token name = cur(); expect(TokenType::IDENT, "Nombre de metodo esperado");
-        AST* m = new AST("Method"); m->kv["name"] = name.lexeme; m->line = name.line; m->col = name.col;
+        AST* m = newNode("Method"); m->set("name", text(name)); m->line = name.line; m->col = name.col;
         expect(TokenType::LBRACE, "Se esperaba '{' en metodo");
         while (cur().type != TokenType::RBRACE && cur().type != TokenType::END_OF_FILE) {
             AST* instr = parseInstruction();
-            if (instr) m->children.push_back(instr);
-            //else { idx++; }
+            if (instr) m->add(instr);
+            //else { ts.advance(); }
         }
         expect(TokenType::RBRACE, "Se esperaba '}' para cerrar metodo");
         return m;
     }
     AST* parseMethodMain(){
         Token mt = cur(); expect(TokenType::METHODMAIN, "Se esperaba 'methodMain'");
-        AST* m = new AST("MethodMain"); m->line = mt.line; m->col = mt.col;
+        AST* m = newNode("MethodMain"); m->line = mt.line; m->col = mt.col;
         expect(TokenType::LBRACE, "Se esperaba '{' en methodMain");
         while (cur().type != TokenType::RBRACE && cur().type != TokenType::END_OF_FILE) {
             AST* instr = parseInstruction();
-            if (instr) m->children.push_back(instr);
-            //else idx++;
+            if (instr) m->add(instr);
+            //else ts.advance();
         }
         expect(TokenType::RBRACE, "Se esperaba '}' para cerrar methodMain");
         return m;
@@ -353,19 +480,32 @@ struct Parser {
     // Instrucciones válidas
     if (tt == TokenType::PRINT) 
         return parsePrint();
+    else if (tt == TokenType::IF) 
+        return parseIf();
+    else if (tt == TokenType::WHILE) 
+        return parseWhile();
+    else if (tt == TokenType::FOR) 
+        return parseFor();
+    else if (tt == TokenType::RETURN) 
+        return parseReturn();
+    else if (tt == TokenType::IDENT && ts.peek(1).type == TokenType::LPAREN)
+        return parseCall();   // llamada = identificador "(" [args] ")" ";" (como en la gramática)
     else if (tt == TokenType::IDENT) 
         return parseAssignment();
 
     // Comentarios dentro de métodos
     else if (tt == TokenType::COMMENT) {
-        idx++; 
+        ts.advance(); 
         return nullptr;
     }
 
-    // Si llega un METHOD dentro de un método o clase, no debe lanzar error aquí
+    // Un METHOD o Class dentro de un método quiere decir que falta su '}'.
+    // (Devolver nullptr aquí dejaba el bucle del método sin avanzar nunca.)
     else if (tt == TokenType::METHOD || tt == TokenType::CLASS) {
-        // no es una instrucción, devolver nullptr para que el nivel superior lo procese
-        return nullptr;
+        Token t = cur();
+        err() << "Error: falta '}' antes de " << tokenTypeName(t.type)
+             << " linea " << t.line << " col " << t.col << "\n";
+        throw runtime_error("Parse error");
     }
 
     // Cierre de bloque o EOF: también se ignoran aquí
@@ -376,7 +516,7 @@ struct Parser {
     // Cualquier otro token realmente inválido
     else {
         Token t = cur();
-        cerr << "Error: instruccion inesperada token " 
+        err() << "Error: instruccion inesperada token " 
              << tokenTypeName(t.type) 
              << " linea " << t.line << "\n";
         throw runtime_error("Parse error");
@@ -385,16 +525,16 @@ struct Parser {
 
     /*AST* parseInstruction(){
         Token c = cur();
-        if (c.type == TokenType::COMMENT) { idx++; return nullptr; }
+        if (c.type == TokenType::COMMENT) { ts.advance(); return nullptr; }
         if (c.type == TokenType::IDENT) {
             
-            Token next = tokens.size() > idx+1 ? tokens[idx+1] : Token{TokenType::END_OF_FILE,"",0,0};
+            Token next = ts.peek(1);
             if (next.type == TokenType::EQUAL) {
                 return parseAssignment();
             } else if (next.type == TokenType::LPAREN) {
                 return parseCall();
             } else {
-                cerr << "Error: instruccion desconocida empezando en identificador linea " << c.line << "\n";
+                err() << "Error: instruccion desconocida empezando en identificador linea " << c.line << "\n";
                 throw runtime_error("Parse error");
             }
         } else if (c.type == TokenType::PRINT) {
@@ -408,7 +548,7 @@ struct Parser {
         } else if (c.type == TokenType::RETURN) {
             return parseReturn();
         } else {
-            cerr << "Error: instruccion inesperada token " << tokenTypeName(c.type) << " linea " << c.line << "\n";
+            err() << "Error: instruccion inesperada token " << tokenTypeName(c.type) << " linea " << c.line << "\n";
             throw runtime_error("Parse error");
         }
     }*/
@@ -418,9 +558,9 @@ struct Parser {
     AST* parseOr() {
         AST* left = parseAnd();
         while (cur().type == TokenType::OROR) {
-            Token op = cur(); match(TokenType::OROR);
+            match(TokenType::OROR);
             AST* right = parseAnd();
-            AST* n = new AST("BinaryOp"); n->kv["op"] = "||"; n->children.push_back(left); n->children.push_back(right);
+            AST* n = newNode("BinaryOp"); n->set("op", "||"); n->add(left); n->add(right);
             left = n;
         }
         return left;
@@ -430,7 +570,7 @@ struct Parser {
         while (cur().type == TokenType::ANDAND) {
             match(TokenType::ANDAND);
             AST* right = parseEquality();
-            AST* n = new AST("BinaryOp"); n->kv["op"] = "&&"; n->children.push_back(left); n->children.push_back(right);
+            AST* n = newNode("BinaryOp"); n->set("op", "&&"); n->add(left); n->add(right);
             left = n;
         }
         return left;
@@ -438,9 +578,9 @@ struct Parser {
     AST* parseEquality() {
         AST* left = parseComparison();
         while (cur().type == TokenType::EQEQ || cur().type == TokenType::NOTEQ) {
-            Token op = cur(); idx++;
+            Token op = cur(); ts.advance();
             AST* right = parseComparison();
-            AST* n = new AST("BinaryOp"); n->kv["op"] = (op.type==TokenType::EQEQ?"==":"!="); n->children.push_back(left); n->children.push_back(right);
+            AST* n = newNode("BinaryOp"); n->set("op", (op.type==TokenType::EQEQ?"==":"!=")); n->add(left); n->add(right);
             left = n;
         }
         return left;
@@ -448,10 +588,10 @@ struct Parser {
     AST* parseComparison() {
         AST* left = parseAdd();
         while (cur().type == TokenType::LT || cur().type == TokenType::GT || cur().type==TokenType::LE || cur().type==TokenType::GE) {
-            Token op = cur(); idx++;
+            Token op = cur(); ts.advance();
             AST* right = parseAdd();
-            string ops = (op.type==TokenType::LT?"<": (op.type==TokenType::GT?">": (op.type==TokenType::LE?"<=":">=")));
-            AST* n = new AST("BinaryOp"); n->kv["op"] = ops; n->children.push_back(left); n->children.push_back(right);
+            const char* ops = (op.type==TokenType::LT?"<": (op.type==TokenType::GT?">": (op.type==TokenType::LE?"<=":">=")));
+            AST* n = newNode("BinaryOp"); n->set("op", ops); n->add(left); n->add(right);
             left = n;
         }
         return left;
@@ -459,9 +599,9 @@ struct Parser {
     AST* parseAdd() {
         AST* left = parseMul();
         while (cur().type == TokenType::PLUS || cur().type == TokenType::MINUS) {
-            Token op = cur(); idx++;
+            Token op = cur(); ts.advance();
             AST* right = parseMul();
-            AST* n = new AST("BinaryOp"); n->kv["op"] = (op.type==TokenType::PLUS?"+":"-"); n->children.push_back(left); n->children.push_back(right);
+            AST* n = newNode("BinaryOp"); n->set("op", (op.type==TokenType::PLUS?"+":"-")); n->add(left); n->add(right);
             left = n;
         }
         return left;
@@ -471,31 +611,31 @@ struct Parser {
         while (cur().type == TokenType::STAR) {
             match(TokenType::STAR);
             AST* right = parseUnary();
-            AST* n = new AST("BinaryOp"); n->kv["op"] = "*"; n->children.push_back(left); n->children.push_back(right);
+            AST* n = newNode("BinaryOp"); n->set("op", "*"); n->add(left); n->add(right);
             left = n;
         }
         return left;
     }
     AST* parseUnary() {
-        if (cur().type == TokenType::NOT) { match(TokenType::NOT); AST* child = parseUnary(); AST* n = new AST("UnaryOp"); n->kv["op"]="!"; n->children.push_back(child); return n; }
-        if (cur().type == TokenType::MINUS) { match(TokenType::MINUS); AST* child = parseUnary(); AST* n = new AST("UnaryOp"); n->kv["op"]="neg"; n->children.push_back(child); return n; }
+        if (cur().type == TokenType::NOT) { match(TokenType::NOT); AST* child = parseUnary(); AST* n = newNode("UnaryOp"); n->set("op", "!"); n->add(child); return n; }
+        if (cur().type == TokenType::MINUS) { match(TokenType::MINUS); AST* child = parseUnary(); AST* n = newNode("UnaryOp"); n->set("op", "neg"); n->add(child); return n; }
         return parsePrimary();
     }
     AST* parsePrimary(){
         Token c = cur();
-        if (c.type == TokenType::NUMBER) { idx++; AST* n = new AST("Number"); n->kv["value"] = c.lexeme; return n; }
-        if (c.type == TokenType::STRING_LITERAL) { idx++; AST* n = new AST("String"); n->kv["value"] = c.lexeme; return n; }
-        if (c.type == TokenType::BOOLEAN_LITERAL) { idx++; AST* n = new AST("Boolean"); n->kv["value"] = c.lexeme; return n; }
-        if (c.type == TokenType::NULL_LITERAL) { idx++; AST* n = new AST("Null"); return n; }
-        if (c.type == TokenType::IDENT) { idx++; AST* n = new AST("Ident"); n->kv["name"] = c.lexeme; return n; }
+        if (c.type == TokenType::NUMBER) { ts.advance(); AST* n = newNode("Number"); n->set("value", text(c)); return n; }
+        if (c.type == TokenType::STRING_LITERAL) { ts.advance(); AST* n = newNode("String"); n->set("value", text(c)); return n; }
+        if (c.type == TokenType::BOOLEAN_LITERAL) { ts.advance(); AST* n = newNode("Boolean"); n->set("value", text(c)); return n; }
+        if (c.type == TokenType::NULL_LITERAL) { ts.advance(); AST* n = newNode("Null"); return n; }
+        if (c.type == TokenType::IDENT) { ts.advance(); AST* n = newNode("Ident"); n->set("name", text(c)); return n; }
         if (c.type == TokenType::LBRACKET) {
             
             match(TokenType::LBRACKET);
-            AST* lst = new AST("List");
+            AST* lst = newNode("List");
             if (cur().type == TokenType::STRING_LITERAL) {
-                AST* s = new AST("String"); s->kv["value"] = cur().lexeme; lst->children.push_back(s); match(TokenType::STRING_LITERAL);
+                AST* s = newNode("String"); s->set("value", text(cur())); lst->add(s); match(TokenType::STRING_LITERAL);
                 while (match(TokenType::COMMA)) {
-                    if (cur().type == TokenType::STRING_LITERAL) { AST* s2 = new AST("String"); s2->kv["value"]=cur().lexeme; lst->children.push_back(s2); match(TokenType::STRING_LITERAL); }
+                    if (cur().type == TokenType::STRING_LITERAL) { AST* s2 = newNode("String"); s2->set("value", text(cur())); lst->add(s2); match(TokenType::STRING_LITERAL); }
                 }
             }
             expect(TokenType::RBRACKET, "falta ']' en lista");
@@ -507,15 +647,15 @@ struct Parser {
             expect(TokenType::RPAREN, "falta ')' en expresion");
             return inner;
         }
-        cerr << "Error: termino inesperado en expresion token " << tokenTypeName(c.type) << " linea " << c.line << "\n";
+        err() << "Error: termino inesperado en expresion token " << tokenTypeName(c.type) << " linea " << c.line << "\n";
         throw runtime_error("Parse error");
     }
     AST* parseBlock(){
         expect(TokenType::LBRACE, "esperado '{' en bloque");
-        AST* blk = new AST("Block");
+        AST* blk = newNode("Block");
         while (cur().type != TokenType::RBRACE && cur().type != TokenType::END_OF_FILE) {
             AST* instr = parseInstruction();
-            if (instr) blk->children.push_back(instr);
+            if (instr) blk->add(instr);
         }
         expect(TokenType::RBRACE, "esperado '}' al final del bloque");
         return blk;
@@ -525,88 +665,88 @@ struct Parser {
         expect(TokenType::EQUAL, "esperado '=' en asignacion");
         AST* expr = parseExpressionNode();
         expect(TokenType::SEMICOLON, "falta ';' en asignacion");
-        AST* node = new AST("Assignment");
-        node->kv["target"] = id.lexeme;
-        node->children.push_back(expr);
+        AST* node = newNode("Assignment");
+        node->set("target", text(id));
+        node->add(expr);
         node->line = id.line; node->col = id.col;
         return node;
     }
     AST* parsePrint(){
         Token p = cur(); expect(TokenType::PRINT, "print esperado");
-        AST* node = new AST("Print"); node->line = p.line; node->col = p.col;
+        AST* node = newNode("Print"); node->line = p.line; node->col = p.col;
         expect(TokenType::LPAREN, "esperado '(' despues de print");
         AST* ex = parseExpressionNode();
-        node->children.push_back(ex);
+        node->add(ex);
         expect(TokenType::RPAREN, "esperado ')' despues de print expr");
         expect(TokenType::SEMICOLON, "falta ';' despues de print()");
         return node;
     }
     AST* parseIf(){
-        Token tk = cur(); expect(TokenType::IF, "if esperado");
+        expect(TokenType::IF, "if esperado");
         expect(TokenType::LPAREN, "esperado '(' despues de if");
         AST* cond = parseExpressionNode();
         expect(TokenType::RPAREN, "esperado ')' luego de condicion");
-        AST* node = new AST("If"); node->children.push_back(cond);
+        AST* node = newNode("If"); node->add(cond);
         AST* thenBlock = parseBlock();
-        node->children.push_back(thenBlock);
+        node->add(thenBlock);
         if (match(TokenType::ELSE)) {
             AST* elseBlock = parseBlock();
-            node->children.push_back(elseBlock);
+            node->add(elseBlock);
         }
         return node;
     }
     AST* parseWhile(){
-        Token tk = cur(); expect(TokenType::WHILE, "while esperado");
+        expect(TokenType::WHILE, "while esperado");
         expect(TokenType::LPAREN, "esperado '(' despues de while");
         AST* cond = parseExpressionNode();
         expect(TokenType::RPAREN, "esperado ')'");
-        AST* node = new AST("While");
-        node->children.push_back(cond);
-        node->children.push_back(parseBlock());
+        AST* node = newNode("While");
+        node->add(cond);
+        node->add(parseBlock());
         return node;
     }
     AST* parseFor(){
-        Token tk = cur(); expect(TokenType::FOR, "for esperado");
+        expect(TokenType::FOR, "for esperado");
         expect(TokenType::LPAREN, "esperado '(' en for");
-        AST* node = new AST("For");
+        AST* node = newNode("For");
        
         if (cur().type == TokenType::IDENT) {
-            node->children.push_back(parseAssignment()); 
+            node->add(parseAssignment()); 
         } else {
             expect(TokenType::SEMICOLON, "esperado ';' en for (init)");
         }
         
         if (cur().type != TokenType::SEMICOLON) {
-            node->children.push_back(parseExpressionNode());
+            node->add(parseExpressionNode());
         }
         expect(TokenType::SEMICOLON, "esperado ';' en for (cond)");
         
         if (cur().type != TokenType::RPAREN) {
-            if (cur().type == TokenType::IDENT) node->children.push_back(parseAssignment());
+            if (cur().type == TokenType::IDENT) node->add(parseAssignment());
             else { /* simple skip */ }
         }
         expect(TokenType::RPAREN, "esperado ')' en for");
-        node->children.push_back(parseBlock());
+        node->add(parseBlock());
         return node;
     }
     AST* parseReturn(){
-        Token tk = cur(); expect(TokenType::RETURN, "return esperado");
-        AST* node = new AST("Return");
+        expect(TokenType::RETURN, "return esperado");
+        AST* node = newNode("Return");
         if (cur().type != TokenType::SEMICOLON) {
-            node->children.push_back(parseExpressionNode());
+            node->add(parseExpressionNode());
         }
         expect(TokenType::SEMICOLON, "falta ';' en return");
         return node;
     }
     AST* parseCall(){
         Token id = cur(); expect(TokenType::IDENT, "identificador esperado en llamada");
-        AST* node = new AST("Call"); node->kv["name"] = id.lexeme; node->line = id.line; node->col = id.col;
+        AST* node = newNode("Call"); node->set("name", text(id)); node->line = id.line; node->col = id.col;
         expect(TokenType::LPAREN, "esperado '(' en llamada");
         if (cur().type != TokenType::RPAREN) {
             vector<AST*> args;
             args.push_back(parseExpressionNode());
             while (match(TokenType::COMMA)) args.push_back(parseExpressionNode());
-            for (auto a: args) node->children.push_back(a);
+            for (auto a: args) node->add(a);
         }
         expect(TokenType::RPAREN, "esperado ')' en llamada");
         expect(TokenType::SEMICOLON, "falta ';' despues de llamada");
@@ -617,37 +757,36 @@ struct Parser {
 
     // FIX #2: nueva lógica dentro de parseAttribute()
     AST* parseAttribute() {
-        Token tipoTok = cur(); idx++;
-        string tipoLex = tokenTypeName(tipoTok.type);
+        Token tipoTok = cur(); ts.advance();
         // caso especial: string [] id = lista ;
         if (tipoTok.type == TokenType::STRING && cur().type == TokenType::LBRACKET) {
             match(TokenType::LBRACKET);
             expect(TokenType::RBRACKET, "Se esperaba ']' después de '[' en atributo string[]");
             Token name = cur(); expect(TokenType::IDENT, "Nombre de atributo esperado después de string[]");
-            AST* a = new AST("Attribute");
-            a->kv["name"] = name.lexeme;
-            a->kv["type"] = "string[]";
+            AST* a = newNode("Attribute");
+            a->set("name", text(name));
+            a->set("type", "string[]");
             a->line = name.line; a->col = name.col;
             expect(TokenType::EQUAL, "Se esperaba '=' en atributo string[]");
             AST* listNode = parsePrimary();
-            AST* init = new AST("Init");
-            init->children.push_back(listNode);
-            a->children.push_back(init);
+            AST* init = newNode("Init");
+            init->add(listNode);
+            a->add(init);
             expect(TokenType::SEMICOLON, "Se esperaba ';' al final del atributo string[]");
             return a;
         }
 
         // caso general: tipo id [= expr] ;
         Token name = cur(); expect(TokenType::IDENT, "Nombre de atributo esperado");
-        AST* a = new AST("Attribute");
-        a->kv["name"] = name.lexeme;
-        a->kv["type"] = (tipoLex=="STRING" ? "string" : (tipoLex=="INT" ? "int" : (tipoLex=="BOOL"? "bool": tipoLex)));
+        AST* a = newNode("Attribute");
+        a->set("name", text(name));
+        a->set("type", tipoTok.type==TokenType::STRING ? "string" : (tipoTok.type==TokenType::INT ? "int" : "bool"));
         a->line = name.line; a->col = name.col;
         if (match(TokenType::EQUAL)) {
             AST* expr = parseExpressionNode();
-            AST* init = new AST("Init");
-            init->children.push_back(expr);
-            a->children.push_back(init);
+            AST* init = newNode("Init");
+            init->add(expr);
+            a->add(init);
         }
         expect(TokenType::SEMICOLON, "Falta ';' después del atributo");
         return a;
@@ -655,27 +794,27 @@ struct Parser {
 };
 
 
-void writeJSON(AST* node, ostream &out, int indent=0) {
+// Escritura anterior, con ostream y sin escapes: solo como referencia para
+// --bench-json (la salida real la arma JsonWriter)
+void writeJSONStream(AST* node, ostream &out, int indent=0) {
     string ind(indent,' ');
     out << ind << "{\n";
     out << ind << "  \"node\": \"" << node->nodeType << "\"";
-    if (!node->kv.empty()) {
+    if (node->nprops > 0) {
         out << ",\n";
         // properties
         out << ind << "  \"props\": {\n";
-        bool first = true;
-        for (auto &kv : node->kv) {
-            if (!first) out << ",\n";
-            out << ind << "    \"" << kv.first << "\": \"" << kv.second << "\"";
-            first = false;
+        for (int i=0;i<node->nprops;++i) {
+            if (i > 0) out << ",\n";
+            out << ind << "    \"" << node->props[i].key << "\": \"" << node->props[i].value << "\"";
         }
         out << "\n" << ind << "  }";
     }
-    if (!node->children.empty()) {
+    if (node->first) {
         out << ",\n" << ind << "  \"children\": [\n";
-        for (size_t i=0;i<node->children.size();++i) {
-            writeJSON(node->children[i], out, indent+4);
-            if (i+1<node->children.size()) out << ",\n";
+        for (AST* c = node->first; c; c = c->next) {
+            writeJSONStream(c, out, indent+4);
+            if (c->next) out << ",\n";
             else out << "\n";
         }
         out << ind << "  ]\n";
@@ -685,39 +824,560 @@ void writeJSON(AST* node, ostream &out, int indent=0) {
     }
 }
 
+/* -------------------- Entrada sintetica y estadisticas -------------------- */
+
+// Programa .brik valido de ~'lines' lineas: clases con atributos y metodos
+// con asignaciones y prints, para medir el lexer y el parser. Con
+// 'comments' cada metodo lleva ademas un bloque /* */ y comentarios de
+// linea largos (entrada donde dominan comentarios y espacios).
+string generateBrik(size_t lines, bool comments = false) {
+    string out;
+    size_t n = 0, cls = 0;
+    while (n < lines) {
+        out += "Class C" + to_string(cls) + (cls ? " extends C0" : "") + "{\n";
+        out += "    // clase generada " + to_string(cls) + "\n";
+        out += "    int a" + to_string(cls) + " = 1;\n";
+        out += "    string nombre = \"c" + to_string(cls) + "\";\n";
+        out += "    string[] piezas = [\"I\",\"O\",\"T\"];\n";
+        n += 5;
+        for (int m = 0; m < 8 && n < lines; ++m) {
+            out += "    method m" + to_string(m) + "{\n";
+            if (comments) {
+                out += "        /*\n";
+                for (int k = 0; k < 12; ++k)
+                    out += "         * Documentacion del metodo m" + to_string(m)
+                         + ": calcula x0..x9 a partir de a, y y listo, linea " + to_string(k) + ".\n";
+                out += "         */\n";
+                n += 14;
+            }
+            for (int k = 0; k < 10; ++k) {
+                if (comments) {
+                    out += "        // paso " + to_string(k) + ": combinar el atributo con la constante y el limite\n";
+                    ++n;
+                }
+                out += "        x" + to_string(k) + " = (a" + to_string(cls) + " + " + to_string(k)
+                     + ") * 2 - y < 10 && !listo;\n";
+                out += "        print(\"valor\" + x" + to_string(k) + ");\n";
+            }
+            out += "    }\n";
+            n += 22;
+        }
+        out += "}\n";
+        ++n; ++cls;
+    }
+    out += "methodMain{\n    print(\"fin\");\n}\n";
+    return out;
+}
+
+/* -------------------- Re-parseo incremental --------------------
+ * Document guarda el programa partido en trozos: cada Class y el methodMain
+ * con su texto y su subárbol, y entre ellos los huecos (espacios y
+ * comentarios). Una edición dentro de un método vuelve a lexear y parsear
+ * solo ese método; en otra parte de una clase, solo la clase; en un hueco,
+ * solo se revisa que siga siendo espacio o comentario. Si el trozo ya no
+ * parsea solo (p. ej. se borró una '}') se parsea todo de nuevo.
+ * Por ahora solo lo usa --bench-edit; main() siempre parsea el archivo entero.
+ */
+struct Document {
+    struct Member {            // método dentro del texto de su clase
+        AST* node;
+        size_t begin, end;     // bytes desde el comienzo de la clase
+        int line;              // líneas desde la primera línea de la clase
+    };
+    struct Chunk {
+        string text;
+        AST* node = nullptr;   // Class o MethodMain; nullptr en los huecos
+        int newlines = 0;
+        bool tail = false;     // lo que sigue a methodMain: el parser no lo mira
+        int lineShift = 0;     // líneas que ganó el trozo y aún no tienen sus nodos
+        vector<Member> members;
+    };
+
+    Arena arena;
+    AST* root = nullptr;       // nullptr si el último parseo completo falló
+    vector<Chunk> chunks;
+    size_t fullBytes = 0;      // Arena usado por el último parseo completo
+
+    // Cómo se resolvieron las ediciones (para --bench-edit)
+    size_t methodParses = 0, classParses = 0, gapEdits = 0, fullParses = 0;
+
+    bool load(string src) { return parseAll(std::move(src)); }
+
+    // El árbol con las líneas al día (root puede tenerlas atrasadas tras
+    // una edición que agrega o quita líneas)
+    AST* tree() {
+        for (Chunk &c : chunks) settleLines(c);
+        return root;
+    }
+
+    string assemble() const {
+        string s;
+        for (const Chunk &c : chunks) s += c.text;
+        return s;
+    }
+
+    // Reemplaza 'removed' bytes desde 'offset' por 'inserted'; false si el
+    // programa resultante no parsea
+    bool edit(size_t offset, size_t removed, string_view inserted) {
+        if (root) {
+            size_t base = 0;
+            int line = 1;
+            for (Chunk &c : chunks) {
+                size_t b = base, e = base + c.text.size();
+                // En una unidad la edición no puede tocar el primer ni el último
+                // byte ("Class"/"method" y la '}' que la cierra)
+                bool inside = c.node ? (b < offset && offset + removed < e)
+                                     : (b <= offset && offset + removed <= e);
+                if (inside) {
+                    size_t lo = offset - b;
+                    int dl = countNewlines(inserted) - countNewlines(string_view(c.text).substr(lo, removed));
+                    settleLines(c);
+                    // Los trozos que siguen cambian de línea: se anota y se
+                    // corrigen sus nodos en tree()
+                    if (dl != 0) {
+                        for (Chunk* d = &c + 1; d != chunks.data() + chunks.size(); ++d) d->lineShift += dl;
+                    }
+                    c.text.replace(lo, removed, inserted.data(), inserted.size());
+                    c.newlines += dl;
+                    bool ok = c.node ? reparseUnit(c, line, lo, removed, inserted.size(), dl) : gapIsInert(c);
+                    if (!ok) return parseAll(assemble());
+                    if (!c.node) ++gapEdits;
+                    // Los subárboles reemplazados quedan en el Arena: cuando la
+                    // basura iguala al árbol vivo, se parsea todo y se libera
+                    if (arena.bytesUsed() > 2 * fullBytes + Arena::BLOCK_SIZE) return parseAll(assemble());
+                    return true;
+                }
+                line += c.newlines;
+                base = e;
+            }
+        }
+        string s = assemble();
+        s.replace(min(offset, s.size()), removed, inserted.data(), inserted.size());
+        return parseAll(std::move(s));
+    }
+
+private:
+    static int countNewlines(string_view s) { return (int)count(s.begin(), s.end(), '\n'); }
+
+    // Los nodos sin posición (line 0, p. ej. literales) se quedan en 0
+    static void shiftLines(AST* n, int dl) {
+        if (n->line > 0) n->line += dl;
+        for (AST* c = n->first; c; c = c->next) shiftLines(c, dl);
+    }
+
+    static void settleLines(Chunk &c) {
+        if (c.lineShift != 0 && c.node) shiftLines(c.node, c.lineShift);
+        c.lineShift = 0;
+    }
+
+    static Chunk makeChunk(const string &src, size_t b, size_t e, AST* node) {
+        Chunk c;
+        c.text = src.substr(b, e - b);
+        c.node = node;
+        c.newlines = countNewlines(c.text);
+        return c;
+    }
+
+    bool parseAll(string src) {
+        ++fullParses;
+        arena.release();
+        chunks.clear();
+        root = nullptr;
+        vector<Parser::Span> spans;
+        try {
+            Lexer lx(src, false);
+            TokenStream ts(lx);
+            Parser p(ts, arena);
+            p.spans = &spans;
+            root = p.parseProgram();
+        } catch (const exception &) {
+            root = nullptr;
+        }
+        if (!root) {
+            chunks.push_back(makeChunk(src, 0, src.size(), nullptr));
+            fullBytes = 0;
+            return false;
+        }
+        size_t pos = 0, firstMember = 0;
+        for (size_t k = 0; k < spans.size(); ++k) {
+            const Parser::Span &s = spans[k];
+            if (s.member) continue;
+            size_t b = s.begin - src.data(), e = s.end - src.data();
+            chunks.push_back(makeChunk(src, pos, b, nullptr));
+            Chunk c = makeChunk(src, b, e, s.node);
+            for (size_t j = firstMember; j < k; ++j) {
+                const Parser::Span &m = spans[j];
+                c.members.push_back({m.node, (size_t)(m.begin - s.begin), (size_t)(m.end - s.begin), m.line - s.line});
+            }
+            firstMember = k + 1;
+            chunks.push_back(std::move(c));
+            pos = e;
+        }
+        chunks.push_back(makeChunk(src, pos, src.size(), nullptr));
+        chunks.back().tail = true;
+        fullBytes = arena.bytesUsed();
+        return true;
+    }
+
+    // Lexea y parsea c.text[from, to) como un método (method) o como la
+    // unidad del trozo; nullptr si no es exactamente eso
+    AST* parseSlice(const Chunk &c, size_t from, size_t to, int line, bool method,
+                    vector<Parser::Span>* spans = nullptr) {
+        string_view all(c.text);
+        size_t nl = from ? all.rfind('\n', from - 1) : string_view::npos;
+        const char* lineStart = all.data() + (nl == string_view::npos ? 0 : nl + 1);
+        Lexer lx(all.substr(from, to - from), Scan::LinePos{line, lineStart}, false);
+        TokenStream ts(lx);
+        Parser p(ts, arena);
+        p.quiet = true;
+        p.spans = spans;
+        try {
+            AST* n = method ? p.parseMethod()
+                   : strcmp(c.node->nodeType, "MethodMain") == 0 ? p.parseMethodMain()
+                   : p.parseClass();
+            return ts.peek().type == TokenType::END_OF_FILE ? n : nullptr;
+        } catch (const exception &) {
+            return nullptr;
+        }
+    }
+
+    // c.text ya tiene la edición en [lo, lo + inserted); line es la primera
+    // línea del trozo y dl las líneas que ganó
+    bool reparseUnit(Chunk &c, int line, size_t lo, size_t removed, size_t inserted, int dl) {
+        long delta = (long)inserted - (long)removed;
+        for (size_t k = 0; k < c.members.size(); ++k) {
+            Member &m = c.members[k];
+            if (!(m.begin < lo && lo + removed < m.end)) continue;
+            AST* fresh = parseSlice(c, m.begin, m.end + delta, line + m.line, true);
+            if (!fresh) break;
+            c.node->replace(m.node, fresh);
+            m.node = fresh;
+            if (dl != 0) {
+                for (AST* n = fresh->next; n; n = n->next) shiftLines(n, dl);   // lo que sigue en la clase
+            }
+            m.end += delta;
+            for (size_t j = k + 1; j < c.members.size(); ++j) {
+                c.members[j].begin += delta;
+                c.members[j].end += delta;
+                c.members[j].line += dl;
+            }
+            ++methodParses;
+            return true;
+        }
+        vector<Parser::Span> spans;
+        AST* fresh = parseSlice(c, 0, c.text.size(), line, false, &spans);
+        if (!fresh) return false;
+        root->replace(c.node, fresh);
+        c.node = fresh;
+        c.members.clear();
+        for (const Parser::Span &s : spans) {
+            c.members.push_back({s.node, (size_t)(s.begin - c.text.data()), (size_t)(s.end - c.text.data()), s.line - line});
+        }
+        ++classParses;
+        return true;
+    }
+
+    // Un hueco sigue siendo inerte si solo tiene comentarios cerrados dentro
+    // de él: un "//" o "/*" abierto al final seguiría en el trozo siguiente
+    bool gapIsInert(const Chunk &c) {
+        if (c.tail) return true;
+        string_view g(c.text);
+        const char* gEnd = g.data() + g.size();
+        Lexer lx(g, true);
+        for (Token t = lx.next(); t.type != TokenType::END_OF_FILE; t = lx.next()) {
+            if (t.type != TokenType::COMMENT) return false;
+            const char* e = t.lexeme.data() + t.lexeme.size();
+            bool block = (t.lexeme.data()[-1] == '*');
+            if (block ? !(gEnd - e >= 2 && e[0] == '*' && e[1] == '/') : e == gEnd) return false;
+        }
+        return lx.p == gEnd;   // un '\0' corta el archivo ahí
+    }
+};
+
+// El JSON no lleva posiciones: se comparan aparte (el .astb sí las guarda)
+bool sameLines(const AST* a, const AST* b) {
+    if (!a || !b) return a == b;
+    if (a->line != b->line || a->col != b->col) return false;
+    for (a = a->first, b = b->first; a || b; a = a->next, b = b->next) {
+        if (!a || !b || !sameLines(a, b)) return false;
+    }
+    return true;
+}
+
+// --bench-edit LINEAS [EDICIONES]: ediciones de un carácter sobre un
+// programa generado (cambiar un dígito, insertar un espacio tras un ';' y
+// borrarlo, o insertar un salto de línea, que se queda y corre las líneas
+// de lo que sigue), comparadas con parsear todo de nuevo
+void benchEdit(size_t lines, int edits) {
+    using Clock = chrono::steady_clock;
+    auto us = [](Clock::duration d) { return chrono::duration<double, micro>(d).count(); };
+    string text = generateBrik(lines);
+    Document doc;
+    auto t0 = Clock::now();
+    doc.load(text);
+    double fullUs = us(Clock::now() - t0);
+
+    mt19937 rng(12345);
+    vector<double> lat;
+    size_t spacePos = 0;
+    for (int k = 0; k < edits; ++k) {
+        size_t off, removed;
+        string ins;
+        if (k % 3 == 0 || (k % 3 == 2 && text[spacePos] == '\n')) {
+            off = text.find_first_of("0123456789", rng() % text.size());
+            if (off == string::npos) off = text.find_first_of("0123456789");
+            removed = 1;
+            ins = string(1, char('0' + (text[off] - '0' + 1) % 10));
+        } else if (k % 3 == 1) {
+            off = text.find(';', rng() % text.size());
+            if (off == string::npos) off = text.find(';');
+            spacePos = off = off + 1;
+            removed = 0;
+            ins = (k % 6 == 1) ? "\n" : " ";
+        } else {
+            off = spacePos;
+            removed = 1;
+        }
+        auto a = Clock::now();
+        doc.edit(off, removed, ins);
+        lat.push_back(us(Clock::now() - a));
+        text.replace(off, removed, ins);
+    }
+    sort(lat.begin(), lat.end());
+    double sum = accumulate(lat.begin(), lat.end(), 0.0);
+
+    // El árbol incremental tiene que ser el mismo que da un parseo completo
+    JsonWriter inc(true), full(true);
+    AST* incRoot = doc.tree();
+    if (incRoot) inc.document(incRoot);
+    Arena arena;
+    Lexer lx(text, false);
+    TokenStream ts(lx);
+    Parser p(ts, arena);
+    AST* fullRoot = p.parseProgram();
+    full.document(fullRoot);
+    bool same = doc.assemble() == text && inc.view() == full.view() && sameLines(incRoot, fullRoot);
+
+    cout << "[Bench] edicion: " << lines << " lineas, " << text.size() << " bytes, parseo completo "
+         << fullUs << " us\n";
+    cout << "[Bench] edicion: " << edits << " ediciones, media " << sum / lat.size() << " us, p50 "
+         << lat[lat.size() / 2] << " us, p99 " << lat[lat.size() * 99 / 100] << " us, max " << lat.back() << " us\n";
+    cout << "[Bench] edicion: metodo " << doc.methodParses << ", clase " << doc.classParses << ", hueco "
+         << doc.gapEdits << ", completo " << doc.fullParses - 1 << "; arbol "
+         << (same ? "igual" : "DISTINTO") << " al del parseo completo\n";
+}
+
+#ifdef JSON_CHECK
+// Mismo árbol que escribe JsonWriter, armado con json.hpp para comparar
+nlohmann::json toJson(const AST* n) {
+    nlohmann::json j;
+    j["node"] = n->nodeType;
+    if (n->nprops > 0) {
+        nlohmann::json props = nlohmann::json::object();
+        for (int i = 0; i < n->nprops; ++i) props[n->props[i].key] = string(n->props[i].value);
+        j["props"] = props;
+    }
+    if (n->first) {
+        nlohmann::json children = nlohmann::json::array();
+        for (const AST* c = n->first; c; c = c->next) children.push_back(toJson(c));
+        j["children"] = children;
+    }
+    return j;
+}
+#endif
+
+// --bench-json REPS: escribe el AST REPS veces con el writeJSON anterior y
+// con JsonWriter (legible y compacto), en memoria, y muestra MB/s
+void benchJson(AST* ast, int reps) {
+    using Clock = chrono::steady_clock;
+    auto best = [&](auto &&fn) {
+        double b = 1e300;
+        for (int r = 0; r < reps; ++r) {
+            auto t0 = Clock::now();
+            fn();
+            b = min(b, chrono::duration<double>(Clock::now() - t0).count());
+        }
+        return b;
+    };
+    string old;
+    double tOld = best([&] {
+        ostringstream out;
+        writeJSONStream(ast, out, 0);
+        out << "\n";
+        old = out.str();
+    });
+    JsonWriter pretty, compact(true);
+    double tPretty = best([&] { pretty.clear(); pretty.document(ast); });
+    double tCompact = best([&] { compact.clear(); compact.document(ast); });
+
+    auto mbs = [](size_t bytes, double s) { return bytes / (1024.0 * 1024.0) / s; };
+    cout << "[Bench] json: anterior  " << old.size() << " bytes, " << tOld * 1000 << " ms, "
+         << mbs(old.size(), tOld) << " MB/s\n";
+    cout << "[Bench] json: legible   " << pretty.size() << " bytes, " << tPretty * 1000 << " ms, "
+         << mbs(pretty.size(), tPretty) << " MB/s (x" << tOld / tPretty << ")"
+         << (pretty.view() == old ? ", mismo texto que el anterior" : ", difiere del anterior (escapes)") << "\n";
+    cout << "[Bench] json: compacto  " << compact.size() << " bytes, " << tCompact * 1000 << " ms, "
+         << mbs(compact.size(), tCompact) << " MB/s (x" << tOld / tCompact << ")\n";
+#ifdef JSON_CHECK
+    nlohmann::json expected = toJson(ast);
+    bool ok = nlohmann::json::parse(pretty.view()) == expected && nlohmann::json::parse(compact.view()) == expected;
+    cout << "[Bench] json: ida y vuelta con json.hpp " << (ok ? "correcta" : "FALLIDA") << "\n";
+#else
+    cout << "[Bench] json: compilar con -DJSON_CHECK para verificar con json.hpp\n";
+#endif
+}
+
+// Lexea la fuente 'reps' veces y muestra el rendimiento en MB/s
+void benchLexer(string_view source, int reps) {
+    using Clock = chrono::steady_clock;
+    double best = 1e300, total = 0;
+    size_t ntokens = 0, allocs = 0;
+    for (int r = 0; r < reps; ++r) {
+        size_t a0 = AllocStats::count;
+        auto t0 = Clock::now();
+        Lexer lx(source);
+        while (lx.next().type != TokenType::END_OF_FILE) {}
+        double s = chrono::duration<double>(Clock::now() - t0).count();
+        allocs = AllocStats::count - a0;
+        ntokens = lx.count;
+        best = min(best, s); total += s;
+    }
+    double mb = source.size() / (1024.0 * 1024.0);
+    cout << "[Bench] lexer: " << reps << " pasadas, " << source.size() << " bytes, " << ntokens << " tokens, "
+         << allocs << " reservas/pasada\n";
+    cout << "[Bench] lexer: mejor " << mb / best << " MB/s, promedio " << mb * reps / total << " MB/s\n";
+}
+
 int main(int argc, char** argv) {
     string filename = "mini-lenguaje.brik";
-    if (argc >= 2) filename = argv[1];
-    ifstream in(filename, ios::binary);
-    if (!in) {
-        cerr << "No se pudo abrir el archivo: " << filename << endl;
-        return 1;
+    bool stats = false;
+    bool useMmap = true;
+    int benchReps = 0;
+    int benchJsonReps = 0;
+    bool compact = false;
+    string binPath;
+    vector<string> positional;
+    for (int a = 1; a < argc; ++a) {
+        string arg = argv[a];
+        if (arg == "--stats") stats = true;
+        else if (arg == "--no-mmap") useMmap = false;   // leer con ifstream (p. ej. si mmap no sirve)
+        else if (arg == "--compact") compact = true;    // arbol.ast sin espacios ni saltos de línea
+        else if (arg == "--bin" && a + 1 < argc) binPath = argv[++a];   // además, el AST binario para Entrega3
+        else if (arg == "--bench-json" && a + 1 < argc) benchJsonReps = max(1, atoi(argv[++a]));   // repeticiones del benchmark del escritor JSON
+        else if (arg == "--bench-lexer" && a + 1 < argc) benchReps = max(1, atoi(argv[++a]));
+        else if (arg == "--bench-edit" && a + 1 < argc) {
+            size_t lines = strtoul(argv[a+1], nullptr, 10);
+            int edits = (a + 2 < argc) ? max(1, atoi(argv[a+2])) : 3000;
+            benchEdit(lines, edits);
+            return 0;
+        }
+        else if ((arg == "--gen" || arg == "--gen-comments") && a + 2 < argc) {
+            // --gen LINEAS ARCHIVO: escribe una entrada sintetica y termina
+            // (--gen-comments: la misma, cargada de comentarios)
+            size_t lines = strtoul(argv[a+1], nullptr, 10);
+            ofstream gout(argv[a+2], ios::binary);
+            gout << generateBrik(lines, arg == "--gen-comments");
+            cout << "Generado " << argv[a+2] << " (" << lines << " lineas)\n";
+            return 0;
+        }
+        else positional.push_back(arg);
     }
-    stringstream buffer; buffer << in.rdbuf();
-    string source = buffer.str();
+    if (!positional.empty()) filename = positional[0];
 
-    
-    Lexer lx(source);
-    lx.tokenize();
+    // Los tokens apuntan dentro de 'source': el archivo mapeado (o el
+    // buffer con --no-mmap) vive hasta el final de main
+    MappedFile mapped;
+    string buffer;
+    string_view source;
+    if (useMmap) {
+        if (!mapped.open(filename)) {
+            cerr << "No se pudo abrir el archivo: " << filename << endl;
+            return 1;
+        }
+        source = mapped.view();
+    } else {
+        ifstream in(filename, ios::binary);
+        if (!in) {
+            cerr << "No se pudo abrir el archivo: " << filename << endl;
+            return 1;
+        }
+        stringstream ss; ss << in.rdbuf();
+        buffer = ss.str();
+        source = buffer;
+    }
 
-    
-    ofstream tokout("tokens.txt");
-    for (auto &t : lx.tokens) {
-        tokout << t.line << ":" << t.col << " " << tokenTypeName(t.type) << " -> " << t.lexeme << "\n";
+    if (benchReps > 0) { benchLexer(source, benchReps); return 0; }
+
+    // tokens.txt sale de una pasada propia del lexer (con comentarios), que
+    // además se completa aunque el parser falle. Con --stats se cronometra
+    // esa misma pasada sin escribir nada.
+    using Clock = chrono::steady_clock;
+    size_t allocs0 = AllocStats::count;
+    auto t0 = Clock::now();
+    Lexer lx(source);
+    if (stats) {
+        while (lx.next().type != TokenType::END_OF_FILE) {}
+    } else {
+        ofstream tokout("tokens.txt");
+        for (Token t = lx.next(); ; t = lx.next()) {
+            tokout << t.line << ":" << t.col << " " << tokenTypeName(t.type) << " -> ";
+            if (t.escaped) unescape(t.lexeme, [&](char ch) { tokout.put(ch); });
+            else tokout << t.lexeme;
+            tokout << "\n";
+            if (t.type == TokenType::END_OF_FILE) break;
+        }
+        tokout.close();
     }
-    tokout.close();
+    auto t1 = Clock::now();
+    size_t allocsLexer = AllocStats::count - allocs0;
 
     try {
-        Parser p(lx.tokens);
+        // El parser consume un segundo Lexer sin comentarios a medida que
+        // avanza: no hay vector con todos los tokens
+        Arena arena;   // todo el arbol se libera junto al salir de este bloque
+        Lexer plx(source, false);
+        TokenStream ts(plx);
+        Parser p(ts, arena);
+        size_t allocs1 = AllocStats::count;
+        auto t2 = Clock::now();
         AST* ast = p.parseProgram();
-        ofstream fout("arbol.ast");
-        writeJSON(ast, fout, 0);
-        fout << "\n";
-        fout.close();
+        auto t3 = Clock::now();
+        size_t allocsParser = AllocStats::count - allocs1;
+
+        if (benchJsonReps > 0) { benchJson(ast, benchJsonReps); return 0; }
+        if (stats) {
+            auto ms = [](Clock::duration d) { return chrono::duration<double, milli>(d).count(); };
+            cout << "[Stats] " << filename << ": " << source.size() << " bytes, "
+                 << lx.pos.line << " lineas, " << lx.count << " tokens (" << plx.count << " sin comentarios), "
+                 << p.nodeCount << " nodos\n";
+            cout << "[Stats] lexer:  " << ms(t1 - t0) << " ms ("
+                 << source.size() / (1024.0 * 1024.0) / chrono::duration<double>(t1 - t0).count() << " MB/s, "
+                 << (useMmap ? "mmap" : "ifstream") << "), " << allocsLexer << " reservas\n";
+            cout << "[Stats] parser: " << ms(t3 - t2) << " ms con su lexer, " << allocsParser << " reservas"
+                 << " (arena: " << arena.blockCount() << " bloques, " << arena.bytesUsed() << " bytes)\n";
+            return 0;
+        }
+
+        JsonWriter out(compact);
+        out.reserve(p.nodeCount * (compact ? 40 : 100));
+        out.document(ast);
+        if (!out.save("arbol.ast")) {
+            cerr << "No se pudo escribir arbol.ast\n";
+            return 1;
+        }
         cout << "AST generado: arbol.ast\n";
+        if (!binPath.empty()) {
+            BinaryWriter bin;
+            bin.document(ast);
+            if (!bin.save(binPath.c_str())) {
+                cerr << "No se pudo escribir " << binPath << "\n";
+                return 1;
+            }
+            cout << "AST binario generado: " << binPath << " (" << bin.size() << " bytes)\n";
+        }
     } catch (const exception &e) {
         cerr << "Parsing fallido: " << e.what() << "\n";
         return 1;
     }
     return 0;
-}
\ No newline at end of file
+}
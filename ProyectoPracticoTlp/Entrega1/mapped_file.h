@@ -0,0 +1,82 @@
+#pragma once
+/* -------------------- Archivo mapeado en memoria --------------------
+ * Vista de solo lectura del archivo completo, sin copiarlo a un string.
+ * mmap en POSIX, CreateFileMapping/MapViewOfFile en Windows.
+ */
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+struct MappedFile {
+    MappedFile() = default;
+    explicit MappedFile(const std::string &path) { open(path); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const std::string &path) {
+        close();
+#ifdef _WIN32
+        HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (f == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(f, &size)) { CloseHandle(f); return false; }
+        size_ = static_cast<size_t>(size.QuadPart);
+        if (size_ > 0) {
+            mapping_ = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping_) data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        }
+        CloseHandle(f);
+        ok_ = (size_ == 0 || data_ != nullptr);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) { ::close(fd); return false; }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ > 0) {
+            void* p = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                data_ = static_cast<const char*>(p);
+                madvise(p, size_, MADV_SEQUENTIAL);   // el lexer lo recorre una vez, en orden
+            }
+        }
+        ::close(fd);
+        ok_ = (size_ == 0 || data_ != nullptr);
+#endif
+        if (!ok_) size_ = 0;
+        return ok_;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        mapping_ = nullptr;
+#else
+        if (data_) munmap(const_cast<char*>(data_), size_);
+#endif
+        data_ = nullptr; size_ = 0; ok_ = false;
+    }
+
+    bool is_open() const { return ok_; }
+    std::string_view view() const { return std::string_view(data_, size_); }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool ok_ = false;
+#ifdef _WIN32
+    HANDLE mapping_ = nullptr;
+#endif
+};
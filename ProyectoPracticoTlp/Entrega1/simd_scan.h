@@ -0,0 +1,213 @@
+#pragma once
+/* -------------------- Búsquedas vectorizadas del lexer --------------------
+ * Cada función avanza desde p hasta el primer byte que le interesa al lexer
+ * (fin de espacios, fin de línea, "*" + "/", comilla, fin de identificador)
+ * de a 32 bytes con AVX2 o de a 16 con SSE2; el resto, y las máquinas sin
+ * SSE2, usan el mismo bucle byte a byte. Las líneas saltadas se cuentan con
+ * popcount sobre la máscara de '\n'. Las rachas de espacios y los
+ * identificadores casi siempre miden menos de 16 bytes y ahí el bloque
+ * cuesta más que el bucle: esas dos búsquedas miran antes SCAN_PROLOGUE
+ * bytes uno a uno y solo pasan a bloques si la racha sigue. Compilar con
+ * -DSCAN_SCALAR fuerza la versión escalar (para comparar con --bench-lexer).
+ */
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(SCAN_SCALAR) && defined(__AVX2__)
+#include <immintrin.h>
+#define SCAN_WIDTH 32
+#elif !defined(SCAN_SCALAR) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define SCAN_WIDTH 16
+#else
+#define SCAN_WIDTH 0
+#endif
+
+#if SCAN_WIDTH && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace Scan {
+
+#if SCAN_WIDTH
+// Operaciones de bits sobre las máscaras (m != 0 en lowBit/highBit). MSVC no
+// tiene los __builtin_*; su popcount por hardware exige POPCNT, que x64 con
+// solo SSE2 no garantiza, así que ahí se cuenta a mano.
+#if defined(_MSC_VER) && !defined(__clang__)
+inline int bitCount(uint32_t m) {
+    m = m - ((m >> 1) & 0x55555555u);
+    m = (m & 0x33333333u) + ((m >> 2) & 0x33333333u);
+    return (int)((((m + (m >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+}
+inline int lowBit(uint32_t m)  { unsigned long k; _BitScanForward(&k, m); return (int)k; }
+inline int highBit(uint32_t m) { unsigned long k; _BitScanReverse(&k, m); return (int)k; }
+#else
+inline int bitCount(uint32_t m) { return __builtin_popcount(m); }
+inline int lowBit(uint32_t m)   { return __builtin_ctz(m); }
+inline int highBit(uint32_t m)  { return 31 - __builtin_clz(m); }
+#endif
+#endif
+
+const int SCAN_PROLOGUE = 16;
+
+inline bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+inline bool isIdentChar(char c) {
+    unsigned char u = (unsigned char)c;
+    return ((u | 0x20) >= 'a' && (u | 0x20) <= 'z') || (u >= '0' && u <= '9') || u == '_' || u >= 128;
+}
+
+// Posición de trabajo del lexer: línea actual y comienzo de esa línea
+struct LinePos {
+    int line;
+    const char* lineStart;
+};
+
+#if SCAN_WIDTH
+typedef uint32_t Mask;   // un bit por byte del bloque
+
+#if SCAN_WIDTH == 32
+typedef __m256i Vec;
+inline Vec  load(const char* p)   { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+inline Vec  splat(char c)         { return _mm256_set1_epi8(c); }
+inline Vec  eqv(Vec a, Vec b)     { return _mm256_cmpeq_epi8(a, b); }
+inline Vec  gtv(Vec a, Vec b)     { return _mm256_cmpgt_epi8(a, b); }
+inline Vec  andv(Vec a, Vec b)    { return _mm256_and_si256(a, b); }
+inline Vec  orv(Vec a, Vec b)     { return _mm256_or_si256(a, b); }
+inline Mask bits(Vec v)           { return (Mask)_mm256_movemask_epi8(v); }
+const Mask FULL = 0xFFFFFFFFu;
+#else
+typedef __m128i Vec;
+inline Vec  load(const char* p)   { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+inline Vec  splat(char c)         { return _mm_set1_epi8(c); }
+inline Vec  eqv(Vec a, Vec b)     { return _mm_cmpeq_epi8(a, b); }
+inline Vec  gtv(Vec a, Vec b)     { return _mm_cmpgt_epi8(a, b); }
+inline Vec  andv(Vec a, Vec b)    { return _mm_and_si128(a, b); }
+inline Vec  orv(Vec a, Vec b)     { return _mm_or_si128(a, b); }
+inline Mask bits(Vec v)           { return (Mask)_mm_movemask_epi8(v); }
+const Mask FULL = 0xFFFFu;
+#endif
+
+inline Mask eq(Vec v, char c) { return bits(eqv(v, splat(c))); }
+
+// Suma las líneas de los '\n' marcados en 'nl' (bloque que empieza en p)
+inline void countLines(Mask nl, const char* p, LinePos &lp) {
+    if (!nl) return;
+    lp.line += bitCount(nl);
+    lp.lineStart = p + highBit(nl) + 1;
+}
+
+// Bytes que siguen un identificador: letras, dígitos, '_' y >= 128 (UTF-8)
+inline Mask identBits(Vec v) {
+    Vec lower = orv(v, splat(0x20));
+    Vec letter = andv(gtv(lower, splat('a' - 1)), gtv(splat('z' + 1), lower));
+    Vec digit  = andv(gtv(v, splat('0' - 1)), gtv(splat('9' + 1), v));
+    Vec high   = gtv(splat(0), v);   // con signo: >= 128 es negativo
+    return bits(orv(orv(letter, digit), orv(high, eqv(v, splat('_')))));
+}
+#endif
+
+// Primer byte que no es espacio, '\t', '\r' ni '\n'
+inline const char* skipSpaces(const char* p, const char* end, LinePos &lp) {
+#if SCAN_WIDTH
+    for (int k = 0; k < SCAN_PROLOGUE; ++k, ++p) {
+        if (p == end || !isSpace(*p)) return p;
+        if (*p == '\n') { ++lp.line; lp.lineStart = p + 1; }
+    }
+    while (end - p >= SCAN_WIDTH) {
+        Vec v = load(p);
+        Mask nl = eq(v, '\n');
+        Mask ws = nl | eq(v, ' ') | eq(v, '\t') | eq(v, '\r');
+        Mask stop = ~ws & FULL;
+        if (stop) {
+            int k = lowBit(stop);
+            countLines(nl & ((1u << k) - 1), p, lp);
+            return p + k;
+        }
+        countLines(nl, p, lp);
+        p += SCAN_WIDTH;
+    }
+#endif
+    while (p < end && isSpace(*p)) {
+        if (*p == '\n') { ++lp.line; lp.lineStart = p + 1; }
+        ++p;
+    }
+    return p;
+}
+
+// Primer '\n' o '\0' (fin de comentario de línea); end si no hay
+inline const char* findLineEnd(const char* p, const char* end) {
+#if SCAN_WIDTH
+    while (end - p >= SCAN_WIDTH) {
+        Vec v = load(p);
+        Mask m = eq(v, '\n') | eq(v, '\0');
+        if (m) return p + lowBit(m);
+        p += SCAN_WIDTH;
+    }
+#endif
+    while (p < end && *p != '\n' && *p != '\0') ++p;
+    return p;
+}
+
+// Primer "*" seguido de "/", o '\0'; end si no hay. Cuenta las líneas saltadas.
+inline const char* findBlockEnd(const char* p, const char* end, LinePos &lp) {
+#if SCAN_WIDTH
+    while (end - p > SCAN_WIDTH) {   // p[SCAN_WIDTH] existe para mirar el '/'
+        Vec v = load(p);
+        Mask nl = eq(v, '\n');
+        Mask m = (eq(v, '*') & eq(load(p + 1), '/')) | eq(v, '\0');
+        if (m) {
+            int k = lowBit(m);
+            countLines(nl & ((1u << k) - 1), p, lp);
+            return p + k;
+        }
+        countLines(nl, p, lp);
+        p += SCAN_WIDTH;
+    }
+#endif
+    while (p < end && *p != '\0' && !(*p == '*' && p + 1 < end && p[1] == '/')) {
+        if (*p == '\n') { ++lp.line; lp.lineStart = p + 1; }
+        ++p;
+    }
+    return p;
+}
+
+// Primer '"', '\\' o '\0' dentro de un literal; end si no hay. Cuenta líneas.
+inline const char* findStringStop(const char* p, const char* end, LinePos &lp) {
+#if SCAN_WIDTH
+    while (end - p >= SCAN_WIDTH) {
+        Vec v = load(p);
+        Mask nl = eq(v, '\n');
+        Mask m = eq(v, '"') | eq(v, '\\') | eq(v, '\0');
+        if (m) {
+            int k = lowBit(m);
+            countLines(nl & ((1u << k) - 1), p, lp);
+            return p + k;
+        }
+        countLines(nl, p, lp);
+        p += SCAN_WIDTH;
+    }
+#endif
+    while (p < end && *p != '"' && *p != '\\' && *p != '\0') {
+        if (*p == '\n') { ++lp.line; lp.lineStart = p + 1; }
+        ++p;
+    }
+    return p;
+}
+
+// Primer byte que no puede seguir un identificador
+inline const char* identEnd(const char* p, const char* end) {
+#if SCAN_WIDTH
+    for (int k = 0; k < SCAN_PROLOGUE; ++k, ++p) {
+        if (p == end || !isIdentChar(*p)) return p;
+    }
+    while (end - p >= SCAN_WIDTH) {
+        Mask stop = ~identBits(load(p)) & FULL;
+        if (stop) return p + lowBit(stop);
+        p += SCAN_WIDTH;
+    }
+#endif
+    while (p < end && isIdentChar(*p)) ++p;
+    return p;
+}
+
+} // namespace Scan
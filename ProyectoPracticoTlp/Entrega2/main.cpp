@@ -3,15 +3,18 @@
 #include <SDL_ttf.h>
 #include <string>
 #include <iostream>
-#include <chrono>
+#include <cmath>
 
-using namespace std::chrono_literals;
+// Ritmo de frames compartido con el motor de Entrega3. Compilar con:
+//   g++ -std=c++17 -I../Entrega3/src main.cpp ../Entrega3/src/engine/frame_scheduler.cpp
+//       $(sdl2-config --cflags --libs) -lSDL2_ttf -o main
+#include "engine/frame_scheduler.h"
 
 // ---------------- Configuración ----------------
 const int WIN_W = 640;
 const int WIN_H = 480;
 const int TARGET_FPS = 60;
-const int FRAME_DELAY_MS = 1000 / TARGET_FPS;
+const long long STEP_NS = 1000000000LL / TARGET_FPS;   // paso fijo de la lógica
 
 // Brick (ladrillo) 
 struct Brick {
@@ -113,16 +116,13 @@ int main(int argc, char** argv) {
     // Ejemplo 
     Brick sampleBrick{ 100, 60, 50, 20, {70,160,220,255} };
 
-    auto lastTime = std::chrono::high_resolution_clock::now();
+    // La lógica avanza en pasos fijos de 1/TARGET_FPS s y cada frame espera
+    // a su deadline absoluto (ver frame_scheduler.h)
+    Engine::FrameScheduler sched(STEP_NS);
+    const double dt = STEP_NS / 1e9; // segundos
 
     // Bucle principal
     while (!input.quit) {
-        // Tiempo
-        auto now = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> dtf = now - lastTime;
-        lastTime = now;
-        double dt = dtf.count(); // segundos
-
         // Eventos
         SDL_Event ev;
         while (SDL_PollEvent(&ev)) {
@@ -139,23 +139,25 @@ int main(int argc, char** argv) {
             }
         }
 
-        // Actualizar lógica
-        int move = 0;
-        if (input.left) move -= 1;
-        if (input.right) move += 1;
-
-        player.x += (int)std::round(move * playerSpeed * dt);
-        // limitar a ventana
-        if (player.x < 0) player.x = 0;
-        if (player.x + player.w > WIN_W) player.x = WIN_W - player.w;
-
-        // para demostración, si el jugador toca el sampleBrick sube score
-        SDL_Rect rPlayer{ player.x, player.y, player.w, player.h };
-        SDL_Rect rSample{ sampleBrick.x, sampleBrick.y, sampleBrick.w, sampleBrick.h };
-        if (SDL_HasIntersection(&rPlayer, &rSample)) {
-            score += 1;
-            // alejar sample brick para evitar sumar infinito
-            sampleBrick.x = (sampleBrick.x + 120) % (WIN_W - sampleBrick.w);
+        // Actualizar lógica: los pasos que correspondan al tiempo transcurrido
+        for (int steps = sched.advance(); steps > 0; --steps) {
+            int move = 0;
+            if (input.left) move -= 1;
+            if (input.right) move += 1;
+
+            player.x += (int)std::round(move * playerSpeed * dt);
+            // limitar a ventana
+            if (player.x < 0) player.x = 0;
+            if (player.x + player.w > WIN_W) player.x = WIN_W - player.w;
+
+            // para demostración, si el jugador toca el sampleBrick sube score
+            SDL_Rect rPlayer{ player.x, player.y, player.w, player.h };
+            SDL_Rect rSample{ sampleBrick.x, sampleBrick.y, sampleBrick.w, sampleBrick.h };
+            if (SDL_HasIntersection(&rPlayer, &rSample)) {
+                score += 1;
+                // alejar sample brick para evitar sumar infinito
+                sampleBrick.x = (sampleBrick.x + 120) % (WIN_W - sampleBrick.w);
+            }
         }
 
         // Render
@@ -177,14 +179,12 @@ int main(int argc, char** argv) {
 
         SDL_RenderPresent(renderer);
 
-        // Control simple de FPS
-        auto frameTime = std::chrono::high_resolution_clock::now() - now;
-        auto frameMs = std::chrono::duration_cast<std::chrono::milliseconds>(frameTime).count();
-        if (frameMs < FRAME_DELAY_MS) {
-            SDL_Delay((Uint32)(FRAME_DELAY_MS - frameMs));
-        }
+        // Esperar al siguiente frame
+        sched.waitForDeadline();
     }
 
+    std::cout << sched.stats().summary() << "\n" << sched.stats().lateSummary() << std::endl;
+
     // Cleanup
     if (font) TTF_CloseFont(font);
     SDL_DestroyRenderer(renderer);
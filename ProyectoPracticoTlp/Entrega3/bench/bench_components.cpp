@@ -0,0 +1,182 @@
+// Micro-benchmark del recorrido de entidades por columnas (EntityStore).
+//
+// Un millón de entidades mezcladas como en una partida grande (60 %
+// serpiente, 30 % Tetris, 5 % comida, 5 % otras) guardadas
+//   - como registro con el tipo en std::string (la Entity original),
+//   - como registro de 24 bytes con el tipo como símbolo (la Entity que
+//     tenía el almacén hasta ahora),
+//   - en las columnas del EntityStore, recorriendo las vistas por clase.
+// Tareas:
+//   - posiciones: sumar gx de todas (solo lee una columna),
+//   - dibujo:     posición y carácter de todas (gx, gy y tipo),
+//   - serpiente:  mover los segmentos de la serpiente (filtrar por tipo
+//                 frente a la vista KIND_SNAKE),
+//   - comida:     sumar la posición de la comida (filtrar frente a la vista).
+// Reporta ns por entidad del almacén y millones de entidades por segundo.
+//
+// Uso: bin/bench_components [entidades] [pasadas]
+
+#include "engine/entity_store.h"
+#include "engine/random.h"
+#include "bench_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using Engine::EntityStore;
+using Engine::Symbol;
+
+struct StringEntity {
+    int id, gx, gy, w, h;
+    std::string type;
+};
+
+struct SymbolEntity {
+    int id, gx, gy, w, h;
+    Symbol type;
+};
+
+static Symbol randomType(Engine::Pcg32 &rng) {
+    unsigned int r = rng.below(100);
+    if (r < 5)  return Engine::TYPE_SNAKE;
+    if (r < 60) return Engine::TYPE_SNAKE_BODY;
+    if (r < 90) return Engine::TYPE_I + static_cast<Symbol>(rng.below(7));
+    if (r < 95) return Engine::TYPE_FOOD;
+    return Engine::TYPE_NONE;
+}
+
+static bool isSnakeName(const std::string &t) { return t == "Snake" || t == "SnakeBody"; }
+static bool isSnakeSymbol(Symbol t) { return t == Engine::TYPE_SNAKE || t == Engine::TYPE_SNAKE_BODY; }
+
+// Una fila de la tabla: las tres variantes de una tarea
+static void report(const char *task, int n, long passes, const double secs[3]) {
+    std::printf("%-12s", task);
+    for (int v = 0; v < 3; ++v) {
+        double ns = secs[v] * 1e9 / (static_cast<double>(passes) * n);
+        std::printf(" %9.2f %8.0f", ns, 1e3 / ns);
+    }
+    std::printf("\n");
+}
+
+int main(int argc, char **argv) {
+    int  n      = argc >= 2 ? std::atoi(argv[1]) : 1000000;
+    long passes = argc >= 3 ? std::atol(argv[2]) : 20;
+
+    std::vector<StringEntity> byName(n);
+    std::vector<SymbolEntity> bySymbol(n);
+    EntityStore store;
+    store.reserve(n);
+
+    Engine::Pcg32 rng(5);
+    for (int i = 0; i < n; ++i) {
+        Symbol t = randomType(rng);
+        int e = store.create(t);
+        store.gx(e) = static_cast<int>(rng.below(1000));
+        store.gy(e) = static_cast<int>(rng.below(1000));
+
+        SymbolEntity &s = bySymbol[i];
+        s.id = store.id(e); s.gx = store.gx(e); s.gy = store.gy(e); s.w = 1; s.h = 1; s.type = t;
+        StringEntity &o = byName[i];
+        o.id = s.id; o.gx = s.gx; o.gy = s.gy; o.w = 1; o.h = 1; o.type = Engine::symbolName(t);
+    }
+
+    std::printf("%d entidades (serpiente %lu, Tetris %lu, comida %lu), %ld pasadas; registro de %lu bytes\n",
+                n, (unsigned long)store.count(Engine::KIND_SNAKE), (unsigned long)store.count(Engine::KIND_TETRIS),
+                (unsigned long)store.count(Engine::KIND_FOOD), passes, (unsigned long)sizeof(SymbolEntity));
+    std::printf("%-12s %18s %18s %18s\n", "", "string", "simbolo", "columnas");
+    std::printf("%-12s %9s %8s %9s %8s %9s %8s\n", "tarea", "ns", "Ment/s", "ns", "Ment/s", "ns", "Ment/s");
+
+    long acc = 0;
+    double secs[3];
+    double t0;
+
+    // Posiciones
+    t0 = Bench::nowSeconds();
+    for (long p = 0; p < passes; ++p)
+        for (int i = 0; i < n; ++i) acc += byName[i].gx;
+    secs[0] = Bench::nowSeconds() - t0;
+    t0 = Bench::nowSeconds();
+    for (long p = 0; p < passes; ++p)
+        for (int i = 0; i < n; ++i) acc += bySymbol[i].gx;
+    secs[1] = Bench::nowSeconds() - t0;
+    t0 = Bench::nowSeconds();
+    for (long p = 0; p < passes; ++p)
+        for (int i = 0; i < n; ++i) acc += store.gx(i);
+    secs[2] = Bench::nowSeconds() - t0;
+    report("posiciones", n, passes, secs);
+
+    // Dibujo: celda y carácter (aquí, la primera letra del tipo)
+    t0 = Bench::nowSeconds();
+    for (long p = 0; p < passes; ++p)
+        for (int i = 0; i < n; ++i) {
+            const StringEntity &e = byName[i];
+            acc += e.gx + e.gy * 1000 + (e.type.empty() ? '?' : e.type[0]);
+        }
+    secs[0] = Bench::nowSeconds() - t0;
+    t0 = Bench::nowSeconds();
+    for (long p = 0; p < passes; ++p)
+        for (int i = 0; i < n; ++i) {
+            const SymbolEntity &e = bySymbol[i];
+            acc += e.gx + e.gy * 1000 + Engine::symbolName(e.type)[0];
+        }
+    secs[1] = Bench::nowSeconds() - t0;
+    t0 = Bench::nowSeconds();
+    for (long p = 0; p < passes; ++p)
+        for (int i = 0; i < n; ++i) acc += store.gx(i) + store.gy(i) * 1000 + Engine::symbolName(store.type(i))[0];
+    secs[2] = Bench::nowSeconds() - t0;
+    report("dibujo", n, passes, secs);
+
+    // Serpiente: un paso a la derecha de cada segmento
+    t0 = Bench::nowSeconds();
+    for (long p = 0; p < passes; ++p)
+        for (int i = 0; i < n; ++i)
+            if (isSnakeName(byName[i].type)) ++byName[i].gx;
+    secs[0] = Bench::nowSeconds() - t0;
+    t0 = Bench::nowSeconds();
+    for (long p = 0; p < passes; ++p)
+        for (int i = 0; i < n; ++i)
+            if (isSnakeSymbol(bySymbol[i].type)) ++bySymbol[i].gx;
+    secs[1] = Bench::nowSeconds() - t0;
+    t0 = Bench::nowSeconds();
+    for (long p = 0; p < passes; ++p) {
+        const std::vector<int> &snake = store.view(Engine::KIND_SNAKE);
+        for (size_t i = 0; i < snake.size(); ++i) ++store.gx(snake[i]);
+    }
+    secs[2] = Bench::nowSeconds() - t0;
+    report("serpiente", n, passes, secs);
+
+    // Comida
+    t0 = Bench::nowSeconds();
+    for (long p = 0; p < passes; ++p)
+        for (int i = 0; i < n; ++i)
+            if (byName[i].type == "Food") acc += byName[i].gx + byName[i].gy;
+    secs[0] = Bench::nowSeconds() - t0;
+    t0 = Bench::nowSeconds();
+    for (long p = 0; p < passes; ++p)
+        for (int i = 0; i < n; ++i)
+            if (bySymbol[i].type == Engine::TYPE_FOOD) acc += bySymbol[i].gx + bySymbol[i].gy;
+    secs[1] = Bench::nowSeconds() - t0;
+    t0 = Bench::nowSeconds();
+    for (long p = 0; p < passes; ++p) {
+        const std::vector<int> &food = store.view(Engine::KIND_FOOD);
+        for (size_t i = 0; i < food.size(); ++i) acc += store.gx(food[i]) + store.gy(food[i]);
+    }
+    secs[2] = Bench::nowSeconds() - t0;
+    report("comida", n, passes, secs);
+
+    // Las tres variantes movieron la serpiente lo mismo
+    long check[3] = { 0, 0, 0 };
+    for (int i = 0; i < n; ++i) {
+        check[0] += byName[i].gx;
+        check[1] += bySymbol[i].gx;
+        check[2] += store.gx(store.indexOf(bySymbol[i].id));
+    }
+    if (check[0] != check[1] || check[1] != check[2]) {
+        std::printf("ERROR: las variantes no coinciden\n");
+        return 1;
+    }
+    Bench::consume(acc);
+    return 0;
+}
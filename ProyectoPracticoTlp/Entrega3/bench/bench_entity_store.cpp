@@ -0,0 +1,109 @@
+// Benchmark del almacén de entidades (slot map) frente al recorrido lineal
+// que usaba findEntity. Escala de 10 a 1.000.000 entidades.
+//
+// Uso: bin/bench_entity_store [lookups]
+
+#include "engine/entity_store.h"
+#include "bench_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+
+// Generador pequeño y determinista (RAND_MAX puede ser 32767 en MinGW)
+static unsigned int gLcg = 12345u;
+static unsigned int nextRand() {
+    gLcg = gLcg * 1664525u + 1013904223u;
+    return gLcg >> 8;
+}
+
+// Registro con el que se comparaba antes de tener columnas
+struct FlatEntity {
+    int id, gx, gy;
+};
+
+static const FlatEntity* linearFind(const std::vector<FlatEntity> &v, int id) {
+    for (size_t i = 0; i < v.size(); ++i) {
+        if (v[i].id == id) return &v[i];
+    }
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    long lookups = 2000000;
+    if (argc >= 2) lookups = std::atol(argv[1]);
+
+    const int sizes[] = { 10, 100, 1000, 10000, 100000, 1000000 };
+    const int nSizes  = sizeof(sizes) / sizeof(sizes[0]);
+    const int LINEAR_LIMIT = 10000;   // por encima, el recorrido lineal tarda demasiado
+
+    std::printf("%10s %12s %12s %12s %12s %14s\n",
+                "entidades", "crear ns", "buscar ns", "iterar ns", "borrar ns", "lineal ns");
+
+    for (int s = 0; s < nSizes; ++s) {
+        int n = sizes[s];
+        Engine::EntityStore store;
+        std::vector<int> ids;
+        ids.reserve(n);
+
+        double t0 = Bench::nowSeconds();
+        for (int i = 0; i < n; ++i) {
+            int e = store.create();
+            store.gx(e) = i % 97;
+            store.gy(e) = i % 89;
+            ids.push_back(store.id(e));
+        }
+        double tCreate = Bench::nowSeconds() - t0;
+
+        t0 = Bench::nowSeconds();
+        long acc = 0;
+        for (long i = 0; i < lookups; ++i) {
+            acc += store.gx(store.indexOf(ids[nextRand() % n]));
+        }
+        double tFind = Bench::nowSeconds() - t0;
+
+        int passes = std::max(1, 10000000 / n);
+        t0 = Bench::nowSeconds();
+        for (int p = 0; p < passes; ++p) {
+            for (int i = 0; i < n; ++i) acc += store.gy(i);
+        }
+        double tIter = Bench::nowSeconds() - t0;
+
+        double linearNs = -1.0;
+        if (n <= LINEAR_LIMIT) {
+            std::vector<FlatEntity> flat(n);
+            for (int i = 0; i < n; ++i) {
+                flat[i].id = store.id(i);
+                flat[i].gx = store.gx(i);
+                flat[i].gy = store.gy(i);
+            }
+            long linLookups = std::min(lookups, 20000000L / n + 1);
+            t0 = Bench::nowSeconds();
+            for (long i = 0; i < linLookups; ++i) {
+                acc += linearFind(flat, ids[nextRand() % n])->gx;
+            }
+            linearNs = (Bench::nowSeconds() - t0) * 1e9 / linLookups;
+        }
+
+        // Borrado en orden aleatorio
+        for (int i = n - 1; i > 0; --i) std::swap(ids[i], ids[nextRand() % (i + 1)]);
+        t0 = Bench::nowSeconds();
+        for (int i = 0; i < n; ++i) store.remove(ids[i]);
+        double tRemove = Bench::nowSeconds() - t0;
+
+        Bench::consume(acc);
+
+        char linearCol[32];
+        if (linearNs < 0) std::sprintf(linearCol, "%s", "-");
+        else              std::sprintf(linearCol, "%.1f", linearNs);
+
+        std::printf("%10d %12.1f %12.1f %12.2f %12.1f %14s\n", n,
+                    tCreate * 1e9 / n,
+                    tFind * 1e9 / lookups,
+                    tIter * 1e9 / (static_cast<double>(passes) * n),
+                    tRemove * 1e9 / n,
+                    linearCol);
+    }
+    return 0;
+}
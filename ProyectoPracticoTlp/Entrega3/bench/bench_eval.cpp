@@ -0,0 +1,257 @@
+// Micro-benchmark: un método con For, If, asignaciones y expresiones,
+// ejecutado por el intérprete (método ya compilado, operadores resueltos y
+// variables en registros) frente a un recorrido directo del AST binario que en
+// cada visita compara el tipo del nodo y el operador con strcmp y guarda las
+// variables en un map<string, int>. Los dos terminan con setScore(total) y
+// deben dejar el mismo puntaje.
+//
+//   total = 0;
+//   for (i = 0; i < N; i = i + 1;) {
+//       t = i * 3 + 1;
+//       if (t > total && !(i == 7)) { total = total + 2; } else { total = total - 1; }
+//   }
+//   setScore(total);
+//
+// Uso: bin/bench_eval [vueltas] [repeticiones]
+
+#include "interpreter/script_interpreter.h"
+#include "interpreter/ast_binary.h"
+#include "interpreter/mapped_file.h"
+#include "engine/world.h"
+#include "bench_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Árbol en memoria que luego se escribe por niveles, como pide el formato
+struct TNode {
+    std::string type;
+    std::vector<std::pair<std::string, std::string> > props;
+    std::vector<TNode*> kids;
+
+    explicit TNode(const char *t) : type(t) {}
+    ~TNode() { for (size_t i = 0; i < kids.size(); ++i) delete kids[i]; }
+    TNode *set(const char *k, const std::string &v) { props.push_back(std::make_pair(std::string(k), v)); return this; }
+    TNode *add(TNode *c) { kids.push_back(c); return this; }
+};
+
+static TNode *num(int v) {
+    char buf[16];
+    std::sprintf(buf, "%d", v);
+    return (new TNode("Number"))->set("value", buf);
+}
+static TNode *ident(const char *n) { return (new TNode("Ident"))->set("name", n); }
+static TNode *bin(const char *op, TNode *l, TNode *r) { return (new TNode("BinaryOp"))->set("op", op)->add(l)->add(r); }
+static TNode *assign(const char *t, TNode *e) { return (new TNode("Assignment"))->set("target", t)->add(e); }
+
+static TNode *program(int loops) {
+    TNode *then = (new TNode("Block"))->add(assign("total", bin("+", ident("total"), num(2))));
+    TNode *els  = (new TNode("Block"))->add(assign("total", bin("-", ident("total"), num(1))));
+    TNode *cond = bin("&&", bin(">", ident("t"), ident("total")),
+                      (new TNode("UnaryOp"))->set("op", "!")->add(bin("==", ident("i"), num(7))));
+    TNode *body = (new TNode("Block"))
+        ->add(assign("t", bin("+", bin("*", ident("i"), num(3)), num(1))))
+        ->add((new TNode("If"))->add(cond)->add(then)->add(els));
+    TNode *loop = (new TNode("For"))
+        ->add(assign("i", num(0)))
+        ->add(bin("<", ident("i"), num(loops)))
+        ->add(assign("i", bin("+", ident("i"), num(1))))
+        ->add(body);
+    TNode *method = (new TNode("Method"))->set("name", "update")
+        ->add(assign("total", num(0)))
+        ->add(loop)
+        ->add((new TNode("Call"))->set("name", "setScore")->add(ident("total")));
+    return (new TNode("Program"))->add((new TNode("Class"))->set("name", "Game")->add(method));
+}
+
+static uint32_t strId(const std::string &s, std::map<std::string, uint32_t> &ids,
+                      std::vector<uint32_t> &offsets, std::string &chars) {
+    std::map<std::string, uint32_t>::iterator it = ids.find(s);
+    if (it != ids.end()) return it->second;
+    uint32_t id = static_cast<uint32_t>(offsets.size());
+    offsets.push_back(static_cast<uint32_t>(chars.size()));
+    chars += s;
+    chars += '\0';
+    ids[s] = id;
+    return id;
+}
+
+static void writeBinary(const char *path, TNode *root) {
+    std::vector<TNode*> order;
+    std::deque<TNode*> queue(1, root);
+    while (!queue.empty()) {
+        order.push_back(queue.front());
+        queue.insert(queue.end(), queue.front()->kids.begin(), queue.front()->kids.end());
+        queue.pop_front();
+    }
+
+    std::map<std::string, uint32_t> ids;
+    std::vector<uint32_t> offsets;
+    std::string chars;
+    std::vector<AstBin::Node> nodes;
+    uint32_t next = 1;
+    for (size_t i = 0; i < order.size(); ++i) {
+        const TNode &t = *order[i];
+        AstBin::Node n;
+        std::memset(&n, 0, sizeof(n));
+        n.type       = strId(t.type, ids, offsets, chars);
+        n.childCount = static_cast<uint32_t>(t.kids.size());
+        n.firstChild = n.childCount ? next : 0;
+        n.nprops     = static_cast<uint32_t>(t.props.size());
+        for (uint32_t p = 0; p < n.nprops; ++p) {
+            n.key[p]   = strId(t.props[p].first, ids, offsets, chars);
+            n.value[p] = strId(t.props[p].second, ids, offsets, chars);
+        }
+        next += n.childCount;
+        nodes.push_back(n);
+    }
+    offsets.push_back(static_cast<uint32_t>(chars.size()));
+
+    AstBin::Header h;
+    std::memset(&h, 0, sizeof(h));
+    AstBin::setMagic(h);
+    h.version       = AstBin::VERSION;
+    h.nodeCount     = static_cast<uint32_t>(nodes.size());
+    h.stringCount   = static_cast<uint32_t>(offsets.size()) - 1;
+    h.nodesOffset   = sizeof(h);
+    h.offsetsOffset = h.nodesOffset + h.nodeCount * sizeof(AstBin::Node);
+    h.charsOffset   = h.offsetsOffset + (h.stringCount + 1) * 4;
+    h.fileSize      = h.charsOffset + static_cast<uint32_t>(chars.size());
+
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(reinterpret_cast<const char*>(&nodes[0]), nodes.size() * sizeof(AstBin::Node));
+    out.write(reinterpret_cast<const char*>(&offsets[0]), offsets.size() * 4);
+    out.write(chars.data(), chars.size());
+}
+
+// Recorrido directo del AST: lo que haría un intérprete que no compila nada
+class NaiveWalker {
+public:
+    NaiveWalker(const AstBin::View &ast, Engine::World &w) : ast_(ast), world_(w) {}
+
+    void run(uint32_t method) { exec(method); }
+
+private:
+    const AstBin::View &ast_;
+    Engine::World &world_;
+    std::map<std::string, int> vars_;
+
+    bool is(const AstBin::Node &n, const char *type) const { return std::strcmp(ast_.str(n.type), type) == 0; }
+
+    const char *prop(const AstBin::Node &n, const char *key) const {
+        for (uint32_t p = 0; p < n.nprops; ++p)
+            if (std::strcmp(ast_.str(n.key[p]), key) == 0) return ast_.str(n.value[p]);
+        return "";
+    }
+
+    int eval(uint32_t i) {
+        const AstBin::Node &n = ast_.node(i);
+        if (is(n, "Number")) return std::atoi(prop(n, "value"));
+        if (is(n, "Ident")) return vars_[prop(n, "name")];
+        if (is(n, "UnaryOp")) {
+            int v = eval(n.firstChild);
+            return std::strcmp(prop(n, "op"), "!") == 0 ? !v : -v;
+        }
+        const char *op = prop(n, "op");
+        int a = eval(n.firstChild);
+        if (std::strcmp(op, "&&") == 0) return a && eval(n.firstChild + 1);
+        if (std::strcmp(op, "||") == 0) return a || eval(n.firstChild + 1);
+        int b = eval(n.firstChild + 1);
+        if (std::strcmp(op, "+") == 0)  return a + b;
+        if (std::strcmp(op, "-") == 0)  return a - b;
+        if (std::strcmp(op, "*") == 0)  return a * b;
+        if (std::strcmp(op, "<") == 0)  return a < b;
+        if (std::strcmp(op, ">") == 0)  return a > b;
+        if (std::strcmp(op, "==") == 0) return a == b;
+        return 0;
+    }
+
+    bool exec(uint32_t i) {
+        const AstBin::Node &n = ast_.node(i);
+        if (is(n, "Method") || is(n, "Block")) {
+            for (uint32_t c = 0; c < n.childCount; ++c)
+                if (!exec(n.firstChild + c)) return false;
+        } else if (is(n, "Assignment")) {
+            vars_[prop(n, "target")] = eval(n.firstChild);
+        } else if (is(n, "If")) {
+            if (eval(n.firstChild)) return exec(n.firstChild + 1);
+            if (n.childCount > 2) return exec(n.firstChild + 2);
+        } else if (is(n, "For")) {
+            exec(n.firstChild);
+            while (eval(n.firstChild + 1)) {
+                exec(n.firstChild + 3);
+                exec(n.firstChild + 2);
+            }
+        } else if (is(n, "Call") && std::strcmp(prop(n, "name"), "setScore") == 0) {
+            world_.setScore(eval(n.firstChild));
+        }
+        return true;
+    }
+};
+
+// Nodo del método "update" dentro del archivo escrito por writeBinary
+static uint32_t findMethod(const AstBin::View &ast) {
+    for (uint32_t i = 0; i < ast.nodeCount(); ++i)
+        if (std::strcmp(ast.str(ast.node(i).type), "Method") == 0) return i;
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    int loops = argc >= 2 ? std::atoi(argv[1]) : 1000000;
+    int reps  = argc >= 3 ? std::atoi(argv[2]) : 5;
+    const char *path = "bin/bench_eval.astb";
+
+    TNode *root = program(loops);
+    writeBinary(path, root);
+    delete root;
+
+    Engine::World wTree, wNaive;
+    wTree.reset();
+    wNaive.reset();
+    ScriptInterpreter interp;
+    interp.bindWorld(wTree);
+    MappedFile file;
+    AstBin::View ast;
+    std::string why;
+    {
+        Bench::QuietStdout quiet;
+        if (!interp.loadASTFile(path) || !file.open(path) || !ast.open(file.data(), file.size(), why)) {
+            std::fprintf(stderr, "no se pudo cargar %s\n", path);
+            return 1;
+        }
+    }
+    uint32_t method = findMethod(ast);
+
+    double bestTree = 1e30, bestNaive = 1e30;
+    {
+        Bench::QuietStdout quiet;
+        interp.compileAll();
+        for (int r = 0; r < reps; ++r) {
+            double t0 = Bench::nowSeconds();
+            interp.callMethod("Game", "update");
+            double t = Bench::nowSeconds() - t0;
+            if (t < bestTree) bestTree = t;
+
+            NaiveWalker walker(ast, wNaive);
+            t0 = Bench::nowSeconds();
+            walker.run(method);
+            t = Bench::nowSeconds() - t0;
+            if (t < bestNaive) bestNaive = t;
+        }
+    }
+
+    std::printf("%d vueltas del for, mejor de %d\n", loops, reps);
+    std::printf("%-22s %12s %12s\n", "ejecucion", "ms", "ns/vuelta");
+    std::printf("%-22s %12.3f %12.1f\n", "recorrido del AST", bestNaive * 1000, bestNaive * 1e9 / loops);
+    std::printf("%-22s %12.3f %12.1f  (x%.1f)\n", "interprete", bestTree * 1000, bestTree * 1e9 / loops, bestNaive / bestTree);
+    std::printf("puntaje %d / %d: %s\n", wNaive.score(), wTree.score(),
+                wNaive.score() == wTree.score() ? "igual" : "DISTINTO");
+    return 0;
+}
@@ -0,0 +1,121 @@
+// Micro-benchmark de la colocación de comida (OccupancyGrid::freeCell).
+//
+// Tableros de 10x20 (el del motor) a 1000x1000 ocupados al 50 %, 90 % y
+// 99 %; se elige una celda libre al azar
+//   - como antes: celdas al azar hasta dar con una libre, con tope de 100
+//     intentos (después se quedaba con una ocupada: "erroneas"),
+//   - igual pero sin tope (correcto, pero el costo crece con la ocupación),
+//   - con la lista de celdas libres de la rejilla.
+// Además mide cuánto cuesta mover una entidad (clearIf + set) ahora que la
+// rejilla mantiene esa lista.
+//
+// Uso: bin/bench_food [colocaciones]
+
+#include "engine/occupancy_grid.h"
+#include "engine/random.h"
+#include "bench_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using Engine::OccupancyGrid;
+
+static volatile int gSink;
+
+// Ocupa 'filled' celdas al azar (ids 1..filled)
+static void fill(OccupancyGrid &g, int filled, Engine::Pcg32 &rng) {
+    int n = g.width() * g.height();
+    std::vector<int> cells(n);
+    for (int i = 0; i < n; ++i) cells[i] = i;
+    for (int i = 0; i < filled; ++i) {
+        int j = i + static_cast<int>(rng.below(static_cast<unsigned int>(n - i)));
+        int t = cells[i]; cells[i] = cells[j]; cells[j] = t;
+        g.set(cells[i] % g.width(), cells[i] / g.width(), i + 1, Engine::CELL_SNAKE_BODY);
+    }
+}
+
+static void benchBoard(int w, int h, int percent, long placements) {
+    OccupancyGrid g(w, h);
+    Engine::Pcg32 rng(7);
+    fill(g, w * h * percent / 100, rng);
+
+    int sink = 0;
+    long wrong = 0;
+    double t0 = Bench::nowSeconds();
+    for (long i = 0; i < placements; ++i) {
+        int x = 0, y = 0;
+        for (int attempts = 0; attempts <= 100; ++attempts) {
+            x = static_cast<int>(rng.below(w));
+            y = static_cast<int>(rng.below(h));
+            if (g.kindAt(x, y) == Engine::CELL_EMPTY) break;
+        }
+        if (g.kindAt(x, y) != Engine::CELL_EMPTY) ++wrong;
+        sink += x + y;
+    }
+    double tCapped = Bench::nowSeconds() - t0;
+
+    t0 = Bench::nowSeconds();
+    for (long i = 0; i < placements; ++i) {
+        int x, y;
+        do {
+            x = static_cast<int>(rng.below(w));
+            y = static_cast<int>(rng.below(h));
+        } while (g.kindAt(x, y) != Engine::CELL_EMPTY);
+        sink += x + y;
+    }
+    double tUnbounded = Bench::nowSeconds() - t0;
+
+    t0 = Bench::nowSeconds();
+    for (long i = 0; i < placements; ++i) {
+        int x, y;
+        g.freeCell(static_cast<int>(rng.below(g.freeCount())), x, y);
+        sink += x + y;
+    }
+    double tList = Bench::nowSeconds() - t0;
+    gSink = sink;
+
+    char board[32];
+    std::sprintf(board, "%dx%d", w, h);
+    std::printf("%10s %5d%% %12.1f %10.2f%% %12.1f %12.1f\n", board, percent,
+                tCapped * 1e9 / placements, 100.0 * wrong / placements,
+                tUnbounded * 1e9 / placements, tList * 1e9 / placements);
+}
+
+// Una entidad que va y viene entre su celda y una libre: clearIf + set
+static void benchMoves(int w, int h, long moves) {
+    OccupancyGrid g(w, h);
+    Engine::Pcg32 rng(11);
+    fill(g, w * h / 2, rng);
+    int x = 0, y = 0;
+    g.freeCell(0, x, y);
+    g.set(x, y, -1, Engine::CELL_SNAKE_HEAD);
+
+    double t0 = Bench::nowSeconds();
+    for (long i = 0; i < moves; ++i) {
+        int nx, ny;
+        g.freeCell(static_cast<int>(rng.below(g.freeCount())), nx, ny);
+        g.clearIf(x, y, -1);
+        g.set(nx, ny, -1, Engine::CELL_SNAKE_HEAD);
+        x = nx;
+        y = ny;
+    }
+    double t = Bench::nowSeconds() - t0;
+    std::printf("mover una entidad en %dx%d: %.1f ns (incluye elegir el destino)\n", w, h, t * 1e9 / moves);
+}
+
+int main(int argc, char** argv) {
+    long placements = argc >= 2 ? std::atol(argv[1]) : 200000;
+
+    std::printf("%ld colocaciones por caso\n", placements);
+    std::printf("%10s %6s %12s %11s %12s %12s\n", "tablero", "lleno", "tope100 ns", "erroneas",
+                "sin tope ns", "lista ns");
+    static const int sizes[][2] = { { 10, 20 }, { 100, 100 }, { 1000, 1000 } };
+    static const int fills[] = { 50, 90, 99 };
+    for (int s = 0; s < 3; ++s) {
+        for (int f = 0; f < 3; ++f) benchBoard(sizes[s][0], sizes[s][1], fills[f], placements);
+    }
+    std::printf("\n");
+    benchMoves(1000, 1000, placements * 5);
+    return 0;
+}
@@ -0,0 +1,88 @@
+// Micro-benchmark del ritmo de frames (engine/frame_scheduler.h).
+//
+// Cada frame hace un trabajo simulado de duración variable (giro sobre el
+// reloj, de 0 a trabajo_max_us) y luego espera al siguiente:
+//   - "sleep relativo": como el bucle anterior, trabajo + usleep(ms),
+//   - FrameScheduler solo durmiendo hasta el deadline absoluto,
+//   - FrameScheduler durmiendo y girando los últimos 200 us.
+// Se reporta el periodo medio, el jitter (desviación del intervalo entre
+// frames), la deriva acumulada frente a frames * ms y el p99 del retraso
+// al despertar.
+//
+// Uso: bin/bench_frame_scheduler [frames] [ms_por_frame] [trabajo_max_us]
+
+#include "engine/frame_scheduler.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+static unsigned int gLcg = 12345u;
+static unsigned int nextRand() {
+    gLcg = gLcg * 1664525u + 1013904223u;
+    return gLcg >> 8;
+}
+
+// Trabajo del frame: gira hasta cumplir 'us' microsegundos
+static void work(long us) {
+    long long end = Engine::monotonicNs() + us * 1000LL;
+    while (Engine::monotonicNs() < end) {}
+}
+
+static void report(const char *name, const Engine::FrameStats &s, long long elapsedNs,
+                   int frames, long long stepNs) {
+    double drift = (elapsedNs - static_cast<long long>(frames) * stepNs) / 1e6;
+    std::printf("%-22s %10.3f %10.3f %10.2f %12ld\n", name, s.meanIntervalMs(), s.jitterMs(),
+                drift, static_cast<long>(s.latePercentileUs(99)));
+}
+
+int main(int argc, char **argv) {
+    int  frames  = argc >= 2 ? std::atoi(argv[1]) : 300;
+    int  ms      = argc >= 3 ? std::atoi(argv[2]) : 5;
+    long maxWork = argc >= 4 ? std::atol(argv[3]) : 2000;
+    long long stepNs = ms * 1000000LL;
+
+    std::printf("%d frames de %d ms, trabajo de 0 a %ld us por frame\n", frames, ms, maxWork);
+    std::printf("%-22s %10s %10s %10s %12s\n", "espera", "periodo ms", "jitter ms", "deriva ms", "p99 retr us");
+
+    // Bucle anterior: el retraso se mide contra el horario ideal inicio + k * paso
+    {
+        gLcg = 12345u;
+        Engine::FrameStats s;
+        long long start = Engine::monotonicNs(), last = -1;
+        for (int f = 0; f < frames; ++f) {
+            work(static_cast<long>(nextRand() % (maxWork + 1)));
+#ifdef _WIN32
+            Sleep(ms);
+#else
+            usleep(static_cast<useconds_t>(ms) * 1000);
+#endif
+            long long now = Engine::monotonicNs();
+            s.record(now - (start + (f + 1) * stepNs), last < 0 ? -1 : now - last);
+            last = now;
+        }
+        report("sleep relativo", s, Engine::monotonicNs() - start, frames, stepNs);
+    }
+
+    const long long spins[] = { 0, Engine::FrameScheduler::DEFAULT_SPIN_NS };
+    const char *names[] = { "deadline absoluto", "deadline + giro 200us" };
+    for (int v = 0; v < 2; ++v) {
+        gLcg = 12345u;
+        Engine::FrameScheduler sched(stepNs, spins[v]);
+        long long start = Engine::monotonicNs();
+        int steps = 0;
+        while (steps < frames) {
+            steps += sched.advance();
+            work(static_cast<long>(nextRand() % (maxWork + 1)));
+            sched.waitForDeadline();
+        }
+        report(names[v], sched.stats(), Engine::monotonicNs() - start, sched.stats().frames, stepNs);
+        std::printf("%-22s %s\n", "", sched.stats().histogramText().c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+// Benchmark de la rejilla de ocupación.
+//
+// 1) Consultas "¿qué hay en (x,y)?" con la rejilla frente al recorrido
+//    lineal de entidades que hacía el motor, en tableros de varios tamaños.
+// 2) Carga aleatoria sobre el motor (Snake + Tetris). Si se compila con
+//    -DENGINE_CHECK_GRID el motor contrasta cada consulta de la rejilla con
+//    el recorrido lineal y al final informa las diferencias encontradas:
+//        make clean && make bench BENCH_FLAGS="-O2 -DENGINE_CHECK_GRID"
+//
+// Uso: bin/bench_grid [operaciones] [semilla]
+
+#include "engine/api.h"
+#include "engine/entity_store.h"
+#include "engine/occupancy_grid.h"
+#include "bench_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+static unsigned int gLcg = 12345u;
+static unsigned int nextRand() {
+    gLcg = gLcg * 1664525u + 1013904223u;
+    return gLcg >> 8;
+}
+
+static void benchQueries(int side) {
+    Engine::EntityStore store;
+    Engine::OccupancyGrid grid(side, side);
+
+    // Ocupa ~1/4 del tablero
+    int n = side * side / 4;
+    for (int i = 0; i < n; ++i) {
+        int e = store.create(Engine::TYPE_SNAKE_BODY);
+        store.gx(e) = nextRand() % side;
+        store.gy(e) = nextRand() % side;
+        grid.set(store.gx(e), store.gy(e), store.id(e), Engine::CELL_SNAKE_BODY);
+    }
+
+    const long queries = 2000000;
+    long hits = 0;
+    double t0 = Bench::nowSeconds();
+    for (long q = 0; q < queries; ++q) {
+        int x = nextRand() % side;
+        int y = nextRand() % side;
+        if (grid.kindAt(x, y) != Engine::CELL_EMPTY) ++hits;
+    }
+    double tGrid = Bench::nowSeconds() - t0;
+
+    long scanQueries = queries / n + 1000;
+    t0 = Bench::nowSeconds();
+    for (long q = 0; q < scanQueries; ++q) {
+        int x = nextRand() % side;
+        int y = nextRand() % side;
+        for (int i = 0; i < n; ++i) {
+            if (store.gx(i) == x && store.gy(i) == y) { ++hits; break; }
+        }
+    }
+    double tScan = Bench::nowSeconds() - t0;
+    Bench::consume(hits);
+
+    std::printf("%6dx%-6d %10d %14.2f %14.1f\n", side, side, n,
+                tGrid * 1e9 / queries, tScan * 1e9 / scanQueries);
+}
+
+static void startRound() {
+    Engine::initEngine();
+    Engine::spawnBlock("Snake", Engine::BOARD_WIDTH / 2, Engine::BOARD_HEIGHT / 2);
+    Engine::spawnBlock("Food", 0, 0);
+}
+
+// Si la partida termina (choque de la serpiente o pila de Tetris llena)
+// se empieza otra para completar las operaciones pedidas.
+static void randomWorkload(long ops) {
+    const int snakeId = 1;
+    long rounds = 1;
+    startRound();
+
+    double t0 = Bench::nowSeconds();
+    for (long done = 0; done < ops; ++done) {
+        if (Engine::isGameEnded()) {
+            startRound();
+            ++rounds;
+        }
+        unsigned int r = nextRand() % 8;
+        if (r < 3) {
+            if (r == 0) Engine::handleKey("wasd"[nextRand() % 4]);
+            Engine::moveEntity(snakeId, 0, 0);
+        } else {
+            int piece = Engine::spawnBlock("I", 0, 0);
+            if (r == 7)      Engine::dropEntity(piece);
+            else if (r == 6) Engine::rotateEntity(piece);
+            else             Engine::moveEntity(piece, static_cast<int>(nextRand() % 3) - 1, 1);
+        }
+    }
+    double secs = Bench::nowSeconds() - t0;
+    Engine::shutdownEngine();
+
+    std::printf("carga aleatoria: %ld operaciones, %ld partidas, %.4f s (%.0f ops/s)\n",
+                ops, rounds, secs, secs > 0 ? ops / secs : 0.0);
+}
+
+int main(int argc, char **argv) {
+    long ops = 1000000;
+    if (argc >= 2) ops = std::atol(argv[1]);
+    if (argc >= 3) gLcg = static_cast<unsigned int>(std::atol(argv[2]));
+
+    std::printf("%-13s %10s %14s %14s\n", "tablero", "ocupadas", "rejilla ns", "lineal ns");
+    const int sides[] = { 10, 32, 100, 316 };
+    for (int i = 0; i < 4; ++i) benchQueries(sides[i]);
+
+    {
+        Bench::QuietStdout quiet;
+        std::srand(gLcg);
+        randomWorkload(ops);
+    }
+    return 0;
+}
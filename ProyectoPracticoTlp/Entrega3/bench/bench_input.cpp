@@ -0,0 +1,166 @@
+// Micro-benchmark de la entrada de teclado (engine/input.h).
+//
+// 1) Costo de consultar si hay teclas cuando no hay ninguna (lo normal en
+//    casi todos los frames): select() con espera cero, como hacía
+//    pollEvents, frente a mirar la cola del hilo lector.
+// 2) Latencia hasta la simulación: un hilo escribe ráfagas de 1 a 4 teclas
+//    en un pipe a intervalos al azar durante el 75 % de la corrida, y un
+//    bucle de frames (FrameScheduler) las consume
+//      - como antes: select() + read() de una tecla por frame,
+//      - con InputReader sobre el pipe, sacando todo lo pendiente.
+//    Se mide desde que la tecla se escribió hasta que el bucle la toma, y
+//    cuántas quedaron sin consumir al terminar.
+//
+// Uso: bin/bench_input [frames] [ms_por_frame]
+
+#include "engine/input.h"
+#include "engine/frame_scheduler.h"
+#include "engine/thread.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/select.h>
+#endif
+
+#ifndef _WIN32
+
+static unsigned int gLcg = 12345u;
+static unsigned int nextRand() {
+    gLcg = gLcg * 1664525u + 1013904223u;
+    return gLcg >> 8;
+}
+
+static volatile int gSink;
+
+static bool readable(int fd) {
+    timeval tv;
+    tv.tv_sec = 0;
+    tv.tv_usec = 0;
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(fd, &fds);
+    return select(fd + 1, &fds, NULL, NULL, &tv) > 0;
+}
+
+struct Writer {
+    int fd;
+    long long untilNs;
+    long long gapMaxUs;
+    std::vector<long long> sentNs;   // hora de escritura de cada tecla (tamaño fijo)
+    size_t sent;
+};
+
+static void writerMain(void* arg) {
+    Writer* w = static_cast<Writer*>(arg);
+    while (Engine::monotonicNs() < w->untilNs && w->sent + 4 <= w->sentNs.size()) {
+        usleep(static_cast<useconds_t>(nextRand() % (w->gapMaxUs + 1)));
+        char burst[4] = { 'w', 'a', 's', 'd' };
+        int n = 1 + static_cast<int>(nextRand() % 4);
+        long long now = Engine::monotonicNs();
+        for (int i = 0; i < n; ++i) w->sentNs[w->sent++] = now;
+        ssize_t r = write(w->fd, burst, n);
+        (void)r;
+    }
+}
+
+static void run(bool reader, int frames, int ms) {
+    int fds[2];
+    if (pipe(fds) != 0) return;
+    gLcg = 12345u;
+
+    long long stepNs = ms * 1000000LL;
+    Writer w;
+    w.fd       = fds[1];
+    w.untilNs  = Engine::monotonicNs() + frames * stepNs * 3 / 4;
+    w.gapMaxUs = ms * 2000LL;
+    w.sentNs.assign(frames * 8, 0);
+    w.sent     = 0;
+
+    Engine::InputReader in;
+    if (reader) in.start(fds[0]);
+    Engine::InputStats stats;
+    Engine::Thread writer;
+    writer.start(&writerMain, &w);
+
+    Engine::FrameScheduler sched(stepNs, 0);
+    size_t taken = 0;
+    for (int f = 0; f < frames; ++f) {
+        long long now = Engine::monotonicNs();
+        long n = 0;
+        if (reader) {
+            Engine::KeyEvent e;
+            while (in.pop(e)) {
+                stats.record(now - w.sentNs[taken++]);
+                ++n;
+            }
+        } else if (readable(fds[0])) {
+            char c;
+            if (read(fds[0], &c, 1) == 1) {
+                stats.record(now - w.sentNs[taken++]);
+                n = 1;
+            }
+        }
+        stats.recordBatch(n);
+        sched.waitForDeadline();
+    }
+
+    writer.join();
+    in.stop();
+    std::printf("%-18s %7lu %7lu %12.0f %12ld %12ld %10lu\n",
+                reader ? "hilo + cola" : "select por frame",
+                static_cast<unsigned long>(w.sent), static_cast<unsigned long>(taken),
+                stats.keys ? stats.latencySumNs / stats.keys / 1000 : 0.0,
+                static_cast<long>(stats.latencyPercentileUs(99)),
+                static_cast<long>(stats.latencyMaxNs / 1000),
+                static_cast<unsigned long>(w.sent - taken));
+    close(fds[0]);
+    close(fds[1]);
+}
+
+int main(int argc, char** argv) {
+    int frames = argc >= 2 ? std::atoi(argv[1]) : 200;
+    int ms     = argc >= 3 ? std::atoi(argv[2]) : 10;
+
+    // 1) Consulta sin teclas pendientes
+    const long polls = 1000000;
+    int fds[2];
+    if (pipe(fds) != 0) return 1;
+    int hits = 0;
+    long long t0 = Engine::monotonicNs();
+    for (long i = 0; i < polls; ++i) hits += readable(fds[0]);
+    double tSelect = (Engine::monotonicNs() - t0) / static_cast<double>(polls);
+
+    Engine::KeyQueue q;
+    Engine::KeyEvent e;
+    t0 = Engine::monotonicNs();
+    for (long i = 0; i < polls; ++i) hits += q.pop(e);
+    double tQueue = (Engine::monotonicNs() - t0) / static_cast<double>(polls);
+    gSink = hits;
+    close(fds[0]);
+    close(fds[1]);
+
+    std::printf("consultar sin teclas (%ld veces)\n", polls);
+    std::printf("%-18s %10.1f ns\n", "select()", tSelect);
+    std::printf("%-18s %10.1f ns  (x%.0f)\n", "cola", tQueue, tSelect / tQueue);
+
+    // 2) Ráfagas de teclas entre frames
+    std::printf("\n%d frames de %d ms, rafagas de 1 a 4 teclas\n", frames, ms);
+    std::printf("%-18s %7s %7s %12s %12s %12s %10s\n", "entrada", "teclas", "tomadas",
+                "media us", "p99 us", "max us", "sin tomar");
+    run(false, frames, ms);
+    run(true, frames, ms);
+    return 0;
+}
+
+#else
+
+int main() {
+    std::printf("bench_input usa pipes y select(): solo en POSIX\n");
+    return 0;
+}
+
+#endif
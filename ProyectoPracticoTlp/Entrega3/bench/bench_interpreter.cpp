@@ -0,0 +1,74 @@
+// Micro-benchmark: comandos/segundo de la ruta textual original frente al
+// bytecode compilado en loadASTFile.
+//
+// Uso: bin/bench_interpreter [frames] [script...]
+
+#include "interpreter/script_interpreter.h"
+#include "engine/api.h"
+#include "bench_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Mide una ruta; -1 si el script no carga, -2 si no tiene texto (.astb).
+// Cada vuelta abre y cierra el motor, también cuando sale antes.
+static double measure(const std::string &script, int frames, bool compiled, long &commands) {
+    ScriptInterpreter interp;
+    if (!interp.loadASTFile(script)) return -1.0;
+
+    interp.compileAll();
+    const Method *update = interp.findMethod("update");
+    commands = update ? static_cast<long>(update->code.size()) * frames : 0;
+    if (!compiled && update && update->commands.empty()) return -2.0;   // .astb: no hay texto
+
+    interp.callMethod("Game", "init");
+    double t0 = Bench::nowSeconds();
+    for (int f = 0; f < frames; ++f) {
+        if (compiled) interp.callMethod("Game", "update");
+        else          interp.callMethodUncompiled("Game", "update");
+    }
+    return Bench::nowSeconds() - t0;
+}
+
+static double runPath(const std::string &script, int frames, bool compiled, long &commands) {
+    Engine::initEngine();
+    double secs = measure(script, frames, compiled, commands);
+    Engine::shutdownEngine();
+    return secs;
+}
+
+int main(int argc, char **argv) {
+    int frames = 1000000;
+    if (argc >= 2) frames = std::atoi(argv[1]);
+
+    std::vector<std::string> scripts;
+    for (int i = 2; i < argc; ++i) scripts.push_back(argv[i]);
+    if (scripts.empty()) {
+        scripts.push_back("games/snake.script");
+        scripts.push_back("games/tetris.script");
+    }
+
+    std::printf("%-22s %-10s %12s %14s\n", "script", "ruta", "segundos", "comandos/s");
+    for (size_t i = 0; i < scripts.size(); ++i) {
+        for (int pass = 0; pass < 2; ++pass) {
+            bool compiled = (pass == 1);
+            long commands = 0;
+            double secs;
+            {
+                Bench::QuietStdout quiet;
+                secs = runPath(scripts[i], frames, compiled, commands);
+            }
+            if (secs == -2.0) continue;
+            if (secs < 0) {
+                std::printf("%-22s no se pudo cargar\n", scripts[i].c_str());
+                break;
+            }
+            std::printf("%-22s %-10s %12.4f %14.0f\n", scripts[i].c_str(),
+                        compiled ? "bytecode" : "texto", secs,
+                        secs > 0 ? commands / secs : 0.0);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+// Micro-benchmark: carga de un .ast.json grande armando el DOM de json.hpp
+// y recorriéndolo, frente a loadASTFile con el lector SAX (script_json.cpp).
+// Cada modo corre en un proceso aparte para que el pico de memoria (RSS)
+// sea solo suyo. Necesita C++11 (json.hpp): se compila con JSON=1.
+//
+// Uso: bin/bench_json_load [metodos] [llamadas]
+//      bin/bench_json_load --run dom|sax|check ARCHIVO   (un solo modo)
+
+#include "interpreter/script_interpreter.h"
+#include "interpreter/mapped_file.h"
+#include "bench_util.h"
+
+#include "json.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+static const char *kPath = "bin/bench_json_load.json";
+
+// Pico de memoria residente del proceso en KB (0 si no se sabe)
+static long peakRssKb() {
+#ifdef _WIN32
+    return 0;
+#else
+    rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_maxrss;
+#endif
+}
+
+static void writeProgram(const char *path, int methods, int calls) {
+    static const char *names[] = { "spawnBlock", "moveEntity", "addScore", "drawText", "setScore" };
+    std::ofstream out(path);
+    out << "{\n  \"node\": \"Root\",\n  \"children\": [\n    {\n      \"node\": \"Class\",\n"
+        << "      \"props\": { \"name\": \"Game\" },\n      \"children\": [\n";
+    for (int m = 0; m < methods; ++m) {
+        out << "        {\n          \"node\": \"Method\",\n          \"props\": { \"name\": \"metodo" << m
+            << "\" },\n          \"children\": [\n";
+        for (int c = 0; c < calls; ++c) {
+            int i = m * calls + c;
+            const char *name = names[i % 5];
+            out << "            {\n              \"node\": \"Call\",\n              \"props\": {\n"
+                << "                \"name\": \"" << name << "\",\n                \"args\": [";
+            if (i % 5 == 0 || i % 5 == 3) out << "\"texto_" << i % 97 << "\", " << i % 40 << ", " << i % 25;
+            else if (i % 5 == 1) out << i % 13 << ", 1, 0";
+            else out << i % 1000;
+            out << "]\n              }\n            }" << (c + 1 < calls ? "," : "") << "\n";
+        }
+        out << "          ]\n        }" << (m + 1 < methods ? "," : "") << "\n";
+    }
+    out << "      ]\n    }\n  ]\n}\n";
+}
+
+// Ruta DOM: el árbol completo en memoria y después las tablas de métodos
+static std::map<std::string, Method> loadDom(const char *path) {
+    MappedFile file;
+    std::map<std::string, Method> methods;
+    if (!file.open(path)) return methods;
+    nlohmann::json root = nlohmann::json::parse(file.data(), file.data() + file.size());
+    for (const nlohmann::json &cls : root["children"]) {
+        for (const nlohmann::json &mj : cls["children"]) {
+            if (mj["node"] != "Method") continue;
+            Method &m = methods[mj["props"]["name"].get<std::string>()];
+            m.name = mj["props"]["name"].get<std::string>();
+            for (const nlohmann::json &cj : mj["children"]) {
+                if (cj["node"] != "Call") continue;
+                Command cmd;
+                cmd.name = cj["props"]["name"].get<std::string>();
+                for (const nlohmann::json &a : cj["props"]["args"])
+                    cmd.args.push_back(a.is_string() ? a.get<std::string>() : a.dump());
+                m.commands.push_back(cmd);
+            }
+        }
+    }
+    return methods;
+}
+
+static int runOne(const std::string &mode, const char *path) {
+    long before = peakRssKb();
+    size_t methods = 0, commands = 0;
+    double t0 = Bench::nowSeconds();
+    if (mode == "dom") {
+        std::map<std::string, Method> m = loadDom(path);
+        methods = m.size();
+        for (std::map<std::string, Method>::iterator it = m.begin(); it != m.end(); ++it)
+            commands += it->second.commands.size();
+    } else {
+        ScriptInterpreter interp;
+        {
+            Bench::QuietStdout quiet;
+            if (!interp.loadASTFile(path)) return 1;
+        }
+        if (mode == "check") {
+            std::map<std::string, Method> dom = loadDom(path);
+            for (std::map<std::string, Method>::iterator it = dom.begin(); it != dom.end(); ++it) {
+                const Method *s = interp.findMethod(it->first);
+                bool same = s && s->commands.size() == it->second.commands.size();
+                for (size_t i = 0; same && i < s->commands.size(); ++i)
+                    same = s->commands[i].name == it->second.commands[i].name &&
+                           s->commands[i].args == it->second.commands[i].args;
+                if (!same) { std::printf("DISTINTO en %s\n", it->first.c_str()); return 1; }
+            }
+            std::printf("SAX y DOM dan las mismas tablas (%lu metodos)\n", static_cast<unsigned long>(dom.size()));
+            return 0;
+        }
+        for (int k = 0; ; ++k) {
+            char name[32];
+            std::sprintf(name, "metodo%d", k);
+            const Method *m = interp.findMethod(name);
+            if (!m) break;
+            ++methods;
+            commands += m->commands.size();
+        }
+    }
+    double t = Bench::nowSeconds() - t0;
+    std::printf("%-6s %10.1f %12ld %12ld %9lu %10lu\n", mode.c_str(), t * 1000, before, peakRssKb(),
+                static_cast<unsigned long>(methods), static_cast<unsigned long>(commands));
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc >= 4 && std::strcmp(argv[1], "--run") == 0) return runOne(argv[2], argv[3]);
+
+    int methods = argc >= 2 ? std::atoi(argv[1]) : 2000;
+    int calls   = argc >= 3 ? std::atoi(argv[2]) : 100;
+    writeProgram(kPath, methods, calls);
+    std::ifstream in(kPath, std::ios::binary | std::ios::ate);
+    std::printf("%s: %d metodos x %d llamadas, %ld bytes\n", kPath, methods, calls, static_cast<long>(in.tellg()));
+    std::printf("%-6s %10s %12s %12s %9s %10s\n", "modo", "ms", "RSS antes KB", "RSS pico KB", "metodos", "comandos");
+    std::fflush(stdout);
+
+    const char *modes[] = { "dom", "sax", "check" };
+    for (int i = 0; i < 3; ++i) {
+        std::string cmd = std::string(argv[0]) + " --run " + modes[i] + " " + kPath;
+        if (std::system(cmd.c_str()) != 0) {
+            std::fprintf(stderr, "fallo el modo %s\n", modes[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,233 @@
+// Micro-benchmark: tiempo de carga de un programa grande como .script de
+// texto (getline + istringstream + compilación) frente al AST binario .astb
+// mapeado, con el costo de solo mapear y recorrer el archivo como piso. Del
+// .astb se mide la carga (tabla de métodos) y la carga más compileAll().
+// Los dos archivos se generan con el mismo programa: METODOS métodos de
+// COMANDOS comandos cada uno, con los ocho comandos del intérprete.
+//
+// Uso: bin/bench_load [metodos] [comandos] [repeticiones]
+
+#include "interpreter/script_interpreter.h"
+#include "interpreter/ast_binary.h"
+#include "interpreter/mapped_file.h"
+#include "bench_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Comando i del programa: nombre y argumentos (las cadenas se repiten poco)
+struct GenCommand {
+    const char *name;
+    std::vector<std::string> args;
+    std::vector<bool> quoted;   // cadena (String) o número (Number)
+};
+
+static GenCommand genCommand(int i) {
+    static const char *names[] = { "spawnBlock", "moveEntity", "rotateEntity", "dropEntity",
+                                   "addScore", "setScore", "endGame", "drawText" };
+    GenCommand c;
+    c.name = names[i % 8];
+    char buf[32];
+    std::vector<std::string> &a = c.args;
+    switch (i % 8) {
+        case 0: case 7:
+            std::sprintf(buf, "texto_%d", i % 97); a.push_back(buf);
+            std::sprintf(buf, "%d", i % 40);       a.push_back(buf);
+            std::sprintf(buf, "%d", i % 25);       a.push_back(buf);
+            break;
+        case 1:
+            std::sprintf(buf, "%d", i % 13); a.push_back(buf);
+            a.push_back("1");
+            a.push_back("0");
+            break;
+        case 6:
+            std::sprintf(buf, "fin_%d", i % 11); a.push_back(buf);
+            break;
+        default:
+            std::sprintf(buf, "%d", i % 1000); a.push_back(buf);
+            break;
+    }
+    c.quoted.assign(a.size(), false);
+    if (i % 8 == 0 || i % 8 == 6 || i % 8 == 7) c.quoted[0] = true;
+    return c;
+}
+
+static void writeScript(const char *path, int methods, int commands) {
+    std::ofstream out(path);
+    for (int m = 0; m < methods; ++m) {
+        out << "[metodo" << m << "]\n";
+        for (int k = 0; k < commands; ++k) {
+            GenCommand c = genCommand(m * commands + k);
+            out << c.name;
+            for (size_t a = 0; a < c.args.size(); ++a) out << ' ' << c.args[a];
+            out << '\n';
+        }
+        out << '\n';
+    }
+}
+
+// El mismo programa como el AST que emite Entrega1 (Program > Class > Method
+// > Call > argumentos), escrito por niveles como pide el formato
+struct BinBuilder {
+    std::vector<AstBin::Node> nodes;
+    std::string chars;
+    std::vector<uint32_t> offsets;
+    std::map<std::string, uint32_t> ids;
+
+    uint32_t str(const std::string &s) {
+        std::map<std::string, uint32_t>::iterator it = ids.find(s);
+        if (it != ids.end()) return it->second;
+        uint32_t id = static_cast<uint32_t>(offsets.size());
+        offsets.push_back(static_cast<uint32_t>(chars.size()));
+        chars += s;
+        chars += '\0';
+        ids[s] = id;
+        return id;
+    }
+
+    void add(const char *type, uint32_t first, uint32_t count, const char *key = NULL, const std::string &value = "") {
+        AstBin::Node n;
+        std::memset(&n, 0, sizeof(n));
+        n.type = str(type);
+        n.firstChild = count ? first : 0;
+        n.childCount = count;
+        if (key) {
+            n.nprops = 1;
+            n.key[0] = str(key);
+            n.value[0] = str(value);
+        }
+        nodes.push_back(n);
+    }
+};
+
+static void writeBinary(const char *path, int methods, int commands) {
+    BinBuilder b;
+    uint32_t M = static_cast<uint32_t>(methods), C = static_cast<uint32_t>(commands);
+    uint32_t callsBase = 2 + M, argsBase = callsBase + M * C;
+
+    b.add("Program", 1, 1);
+    b.add("Class", 2, M, "name", "Game");
+    char buf[32];
+    for (uint32_t m = 0; m < M; ++m) {
+        std::sprintf(buf, "metodo%u", m);
+        b.add("Method", callsBase + m * C, C, "name", buf);
+    }
+    std::vector<GenCommand> all;
+    uint32_t next = argsBase;
+    for (uint32_t i = 0; i < M * C; ++i) {
+        all.push_back(genCommand(static_cast<int>(i)));
+        uint32_t n = static_cast<uint32_t>(all.back().args.size());
+        b.add("Call", next, n, "name", all.back().name);
+        next += n;
+    }
+    for (size_t i = 0; i < all.size(); ++i)
+        for (size_t a = 0; a < all[i].args.size(); ++a)
+            b.add(all[i].quoted[a] ? "String" : "Number", 0, 0, "value", all[i].args[a]);
+    b.offsets.push_back(static_cast<uint32_t>(b.chars.size()));
+
+    AstBin::Header h;
+    std::memset(&h, 0, sizeof(h));
+    AstBin::setMagic(h);
+    h.version       = AstBin::VERSION;
+    h.nodeCount     = static_cast<uint32_t>(b.nodes.size());
+    h.stringCount   = static_cast<uint32_t>(b.offsets.size()) - 1;
+    h.nodesOffset   = sizeof(h);
+    h.offsetsOffset = h.nodesOffset + h.nodeCount * sizeof(AstBin::Node);
+    h.charsOffset   = h.offsetsOffset + (h.stringCount + 1) * 4;
+    h.fileSize      = h.charsOffset + static_cast<uint32_t>(b.chars.size());
+
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(reinterpret_cast<const char*>(&b.nodes[0]), b.nodes.size() * sizeof(AstBin::Node));
+    out.write(reinterpret_cast<const char*>(&b.offsets[0]), b.offsets.size() * 4);
+    out.write(b.chars.data(), b.chars.size());
+}
+
+static long fileSize(const char *path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    return static_cast<long>(in.tellg());
+}
+
+// Piso: mapear el archivo y leer un byte por página
+static double mapOnly(const char *path, int reps) {
+    double best = 1e30;
+    for (int r = 0; r < reps; ++r) {
+        double t0 = Bench::nowSeconds();
+        MappedFile f;
+        if (!f.open(path)) return -1.0;
+        long sum = 0;
+        for (size_t i = 0; i < f.size(); i += 4096) sum += f.data()[i];
+        Bench::consume(sum);
+        double t = Bench::nowSeconds() - t0;
+        if (t < best) best = t;
+    }
+    return best;
+}
+
+static double load(const char *path, int reps, ScriptInterpreter &interp, bool compile) {
+    double best = 1e30;
+    for (int r = 0; r < reps; ++r) {
+        double t0 = Bench::nowSeconds();
+        if (!interp.loadASTFile(path)) return -1.0;
+        if (compile) interp.compileAll();
+        double t = Bench::nowSeconds() - t0;
+        if (t < best) best = t;
+    }
+    return best;
+}
+
+// Las dos cargas deben dar el mismo bytecode (los índices de cadena pueden
+// diferir: se comparan operación y operandos enteros)
+static bool sameCode(const ScriptInterpreter &x, const ScriptInterpreter &y, int methods) {
+    char name[32];
+    for (int m = 0; m < methods; ++m) {
+        std::sprintf(name, "metodo%d", m);
+        const Method *a = x.findMethod(name), *b = y.findMethod(name);
+        if (!a || !b || a->code.size() != b->code.size()) return false;
+        for (size_t i = 0; i < a->code.size(); ++i) {
+            const Instr &p = a->code[i], &q = b->code[i];
+            if (p.op != q.op || p.a != q.a || p.b != q.b || p.c != q.c || (p.str < 0) != (q.str < 0)) return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    int methods  = argc >= 2 ? std::atoi(argv[1]) : 1000;
+    int commands = argc >= 3 ? std::atoi(argv[2]) : 100;
+    int reps     = argc >= 4 ? std::atoi(argv[3]) : 5;
+    const char *scriptPath = "bin/bench_load.script";
+    const char *binPath    = "bin/bench_load.astb";
+
+    writeScript(scriptPath, methods, commands);
+    writeBinary(binPath, methods, commands);
+
+    ScriptInterpreter text, bin;
+    double tText, tBin, tBinAll, tMap;
+    {
+        Bench::QuietStdout quiet;
+        tText   = load(scriptPath, reps, text, false);
+        tBin    = load(binPath, reps, bin, false);
+        tBinAll = load(binPath, reps, bin, true);
+        tMap    = mapOnly(binPath, reps);
+    }
+    if (tText < 0 || tBin < 0 || tBinAll < 0 || tMap < 0) {
+        std::fprintf(stderr, "no se pudieron cargar los archivos generados\n");
+        return 1;
+    }
+
+    long textBytes = fileSize(scriptPath), binBytes = fileSize(binPath);
+    std::printf("%d metodos x %d comandos, mejor de %d\n", methods, commands, reps);
+    std::printf("%-22s %12s %12s\n", "carga", "bytes", "ms");
+    std::printf("%-22s %12ld %12.3f\n", "texto", textBytes, tText * 1000);
+    std::printf("%-22s %12ld %12.3f  (x%.1f)\n", "binario", binBytes, tBin * 1000, tText / tBin);
+    std::printf("%-22s %12ld %12.3f  (x%.1f)\n", "binario + compileAll", binBytes, tBinAll * 1000, tText / tBinAll);
+    std::printf("%-22s %12ld %12.3f\n", "solo mmap", binBytes, tMap * 1000);
+    std::printf("bytecode %s\n", sameCode(text, bin, methods) ? "igual en las dos cargas" : "DISTINTO");
+    return 0;
+}
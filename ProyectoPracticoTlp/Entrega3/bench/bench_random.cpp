@@ -0,0 +1,62 @@
+// Micro-benchmark del generador del motor (engine/random.h).
+//
+// El LCG de rand() con "% n" (lo que usaba World) frente a Pcg32::below(n)
+// para los rangos del motor: ns por número y la mayor desviación de una
+// celda respecto a la frecuencia uniforme, con 200 (celdas del tablero), 7
+// (piezas de Tetris) y 10.000 valores.
+//
+// Uso: bin/bench_random [numeros]
+
+#include "engine/random.h"
+#include "bench_util.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static unsigned int gRng = 1;
+static int lcgRand() {
+    gRng = gRng * 1103515245u + 12345u;
+    return static_cast<int>((gRng >> 16) & 0x7FFFu);
+}
+
+// Desviación máxima de una celda respecto a count / n, en %
+static double maxDeviation(const std::vector<long>& hist, long count) {
+    double expected = static_cast<double>(count) / hist.size();
+    double worst = 0;
+    for (size_t i = 0; i < hist.size(); ++i) {
+        double d = std::fabs(hist[i] - expected) / expected;
+        if (d > worst) worst = d;
+    }
+    return worst * 100.0;
+}
+
+static void benchRange(unsigned int n, long count) {
+    std::vector<long> hLcg(n, 0), hPcg(n, 0);
+
+    gRng = 1;
+    double t0 = Bench::nowSeconds();
+    for (long i = 0; i < count; ++i) ++hLcg[lcgRand() % n];
+    double tLcg = Bench::nowSeconds() - t0;
+
+    Engine::Pcg32 pcg(1);
+    t0 = Bench::nowSeconds();
+    for (long i = 0; i < count; ++i) ++hPcg[pcg.below(n)];
+    double tPcg = Bench::nowSeconds() - t0;
+
+    std::printf("%8u %12.2f %12.2f %12.2f %12.2f\n", n,
+                tLcg * 1e9 / count, tPcg * 1e9 / count,
+                maxDeviation(hLcg, count), maxDeviation(hPcg, count));
+}
+
+int main(int argc, char** argv) {
+    long count = argc >= 2 ? std::atol(argv[1]) : 20000000;
+
+    std::printf("%ld numeros por rango\n", count);
+    std::printf("%8s %12s %12s %12s %12s\n", "rango", "lcg ns", "pcg32 ns", "lcg desv %", "pcg32 desv %");
+    benchRange(200, count);
+    benchRange(7, count);
+    benchRange(10000, count);
+    return 0;
+}
@@ -0,0 +1,88 @@
+// Benchmark de un paso de la serpiente según su longitud: el cuerpo en cola
+// circular (SnakeBody) frente al esquema anterior, que copiaba todas las
+// posiciones a un vector nuevo y reescribía cada segmento en cada tick.
+//
+// Uso: bin/bench_snake
+
+#include "engine/entity_store.h"
+#include "engine/occupancy_grid.h"
+#include "engine/snake_body.h"
+#include "bench_util.h"
+
+#include <cstdio>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+// Serpiente horizontal de 'len' segmentos en una fila de un tablero con
+// el doble de ancho, avanzando a la derecha con vuelta al borde.
+static double benchRing(int len, long ticks) {
+    int width = 2 * len + 16;
+    Engine::EntityStore store;
+    Engine::OccupancyGrid grid(width, 3);
+    Engine::SnakeBody snake;
+
+    store.reserve(len);
+    for (int i = 0; i < len; ++i) {
+        int e = store.create(i == 0 ? Engine::TYPE_SNAKE : Engine::TYPE_SNAKE_BODY);
+        store.gx(e) = len - 1 - i;
+        store.gy(e) = 1;
+        if (i == 0) snake.reset(store.id(e));
+        else        snake.pushTail(store.id(e));
+        grid.set(store.gx(e), 1, store.id(e), i == 0 ? Engine::CELL_SNAKE_HEAD : Engine::CELL_SNAKE_BODY);
+    }
+
+    double t0 = Bench::nowSeconds();
+    for (long t = 0; t < ticks; ++t) {
+        int nx = store.gx(store.indexOf(snake.headId())) + 1;
+        if (nx >= width) nx = 0;
+        snake.step(store, grid, nx, 1, 0);
+    }
+    double secs = Bench::nowSeconds() - t0;
+    Bench::consume(store.gx(store.indexOf(snake.headId())));
+    return secs * 1e9 / ticks;
+}
+
+static double benchCopy(int len, long ticks) {
+    int width = 2 * len + 16;
+    Engine::EntityStore store;
+    std::vector<int> segments;
+    for (int i = 0; i < len; ++i) {
+        int e = store.create();
+        store.gx(e) = len - 1 - i;
+        store.gy(e) = 1;
+        segments.push_back(store.id(e));
+    }
+
+    double t0 = Bench::nowSeconds();
+    for (long t = 0; t < ticks; ++t) {
+        std::vector< std::pair<int,int> > oldPos;
+        oldPos.reserve(segments.size());
+        for (size_t i = 0; i < segments.size(); ++i) {
+            int s = store.indexOf(segments[i]);
+            oldPos.push_back(std::make_pair(store.gx(s), store.gy(s)));
+        }
+        int &headX = store.gx(store.indexOf(segments[0]));
+        headX = headX + 1 >= width ? 0 : headX + 1;
+        for (size_t i = 1; i < segments.size(); ++i) {
+            int seg = store.indexOf(segments[i]);
+            store.gx(seg) = oldPos[i-1].first;
+            store.gy(seg) = oldPos[i-1].second;
+        }
+    }
+    double secs = Bench::nowSeconds() - t0;
+    Bench::consume(store.gx(store.indexOf(segments[0])));
+    return secs * 1e9 / ticks;
+}
+
+int main() {
+    const int lengths[] = { 10, 100, 1000, 10000, 100000 };
+    std::printf("%10s %16s %16s\n", "longitud", "anillo ns/tick", "copia ns/tick");
+    for (int i = 0; i < 5; ++i) {
+        int len = lengths[i];
+        long copyTicks = std::max(100L, 20000000L / len);
+        std::printf("%10d %16.1f %16.1f\n", len,
+                    benchRing(len, 5000000L), benchCopy(len, copyTicks));
+    }
+    return 0;
+}
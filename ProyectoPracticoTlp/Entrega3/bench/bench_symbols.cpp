@@ -0,0 +1,137 @@
+// Micro-benchmark de la tabla de símbolos (engine/symbols.h).
+//
+// 1) Buscar el método a llamar en cada frame: map<string, Method> con el
+//    nombre (lo que hacía callMethod) frente a MethodTable con el símbolo,
+//    con programas de 8 a 10.000 métodos.
+// 2) Clasificar entidades como lo hacen la rejilla y el dibujo (cabeza,
+//    cuerpo o comida, y el carácter de cada tipo): comparando cadenas como
+//    antes frente a comparar símbolos.
+//
+// Uso: bin/bench_symbols [busquedas] [entidades]
+
+#include "interpreter/script_interpreter.h"
+#include "engine/symbols.h"
+#include "bench_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+static unsigned int gLcg = 12345u;
+static unsigned int nextRand() {
+    gLcg = gLcg * 1664525u + 1013904223u;
+    return gLcg >> 8;
+}
+
+static volatile size_t gSink;   // que el compilador no descarte las búsquedas
+
+// Lo que hacía world.cpp con Entity::type como std::string
+
+static int kindByName(const std::string &t) {
+    if (t == "Snake") return 1;
+    if (t == "SnakeBody") return 2;
+    if (t == "Food") return 3;
+    return 0;
+}
+
+static char charByName(const std::string &t) {
+    if (t == "I" || t == "Block") return '#';
+    if (t == "O") return 'O';
+    if (t == "T") return 'T';
+    if (t == "L") return 'L';
+    if (t == "J") return 'J';
+    if (t == "S") return 'S';
+    if (t == "Z") return 'Z';
+    if (t == "Snake") return 'S';
+    if (t == "SnakeBody") return 's';
+    if (t == "Food") return 'F';
+    return '?';
+}
+
+// Lo mismo con Entity::type como símbolo
+static int kindBySymbol(Engine::Symbol t) {
+    if (t == Engine::TYPE_SNAKE) return 1;
+    if (t == Engine::TYPE_SNAKE_BODY) return 2;
+    if (t == Engine::TYPE_FOOD) return 3;
+    return 0;
+}
+
+static char charBySymbol(Engine::Symbol t) {
+    static const char chars[Engine::TYPE_FOOD + 1] = { '?', '#', 'O', 'T', 'L', 'J', 'S', 'Z', '?', '#', 'S', 's', 'F' };
+    return (t >= 0 && t <= Engine::TYPE_FOOD) ? chars[t] : '?';
+}
+
+static void benchMethods(int methods, long lookups) {
+    std::map<std::string, Method> byName;
+    MethodTable bySymbol;
+    char name[32];
+    for (int i = 0; i < methods; ++i) {
+        std::sprintf(name, "metodo%d", i);
+        byName[name].name = name;
+        bySymbol.define(name);
+    }
+    byName["update"].name = "update";
+    bySymbol.define("update");
+
+    const std::string update = "update";
+    const Engine::Symbol sym = Engine::intern(update);
+    size_t sink = 0;
+
+    double t0 = Bench::nowSeconds();
+    for (long i = 0; i < lookups; ++i) {
+        std::map<std::string, Method>::iterator it = byName.find(update);
+        sink += it->second.name.size();
+    }
+    double tName = Bench::nowSeconds() - t0;
+
+    t0 = Bench::nowSeconds();
+    for (long i = 0; i < lookups; ++i) {
+        sink += bySymbol.find(sym)->name.size();
+    }
+    double tSym = Bench::nowSeconds() - t0;
+
+    gSink = sink;
+    std::printf("%8d %14.2f %14.2f %8.1fx\n", methods + 1, tName * 1e9 / lookups,
+                tSym * 1e9 / lookups, tName / tSym);
+}
+
+int main(int argc, char **argv) {
+    long lookups = argc >= 2 ? std::atol(argv[1]) : 5000000;
+    int entities = argc >= 3 ? std::atoi(argv[2]) : 1000000;
+
+    std::printf("buscar el metodo \"update\" (%ld veces)\n", lookups);
+    std::printf("%8s %14s %14s %9s\n", "metodos", "map ns", "simbolo ns", "speedup");
+    int sizes[] = { 8, 100, 1000, 10000 };
+    for (int i = 0; i < 4; ++i) benchMethods(sizes[i], lookups);
+
+    // Los tipos en la proporción de una partida de Snake larga: casi todo
+    // cuerpo, con algunas piezas de Tetris
+    static const Engine::Symbol types[] = {
+        Engine::TYPE_SNAKE_BODY, Engine::TYPE_SNAKE_BODY, Engine::TYPE_SNAKE_BODY,
+        Engine::TYPE_SNAKE_BODY, Engine::TYPE_SNAKE, Engine::TYPE_FOOD,
+        Engine::TYPE_I, Engine::TYPE_T, Engine::TYPE_Z
+    };
+    std::vector<std::string> names(entities);
+    std::vector<Engine::Symbol> symbols(entities);
+    for (int i = 0; i < entities; ++i) {
+        symbols[i] = types[nextRand() % (sizeof(types) / sizeof(types[0]))];
+        names[i] = Engine::symbolName(symbols[i]);
+    }
+
+    long sumName = 0, sumSym = 0;
+    double t0 = Bench::nowSeconds();
+    for (int i = 0; i < entities; ++i) sumName += kindByName(names[i]) * 256 + charByName(names[i]);
+    double tName = Bench::nowSeconds() - t0;
+    t0 = Bench::nowSeconds();
+    for (int i = 0; i < entities; ++i) sumSym += kindBySymbol(symbols[i]) * 256 + charBySymbol(symbols[i]);
+    double tSym = Bench::nowSeconds() - t0;
+
+    std::printf("\nclasificar %d entidades (tipo de celda + caracter)\n", entities);
+    std::printf("%-12s %12s\n", "tipo", "ns/entidad");
+    std::printf("%-12s %12.2f\n", "cadena", tName * 1e9 / entities);
+    std::printf("%-12s %12.2f  (x%.1f)\n", "simbolo", tSym * 1e9 / entities, tName / tSym);
+    std::printf("resultado %s\n", sumName == sumSym ? "igual" : "DISTINTO");
+    return sumName == sumSym ? 0 : 1;
+}
@@ -0,0 +1,49 @@
+// Benchmark del tablero de Tetris en máscaras de bits: coloca un millón de
+// piezas (forma, giro y columna al azar, caída hasta el fondo, fijado y
+// borrado de líneas). Cuando la pila llega arriba se vacía el tablero.
+//
+// Uso: bin/bench_tetris [piezas]
+
+#include "engine/tetris_board.h"
+#include "engine/api.h"
+#include "bench_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+static unsigned int gLcg = 12345u;
+static unsigned int nextRand() {
+    gLcg = gLcg * 1664525u + 1013904223u;
+    return gLcg >> 8;
+}
+
+int main(int argc, char **argv) {
+    long pieces = 1000000;
+    if (argc >= 2) pieces = std::atol(argv[1]);
+
+    Engine::TetrisBoard board(Engine::BOARD_WIDTH, Engine::BOARD_HEIGHT);
+    long lines = 0;
+    long resets = 0;
+
+    double t0 = Bench::nowSeconds();
+    for (long p = 0; p < pieces; ++p) {
+        int shape = nextRand() % Engine::SHAPE_COUNT;
+        int rot   = nextRand() % 4;
+        int x     = static_cast<int>(nextRand() % (Engine::BOARD_WIDTH + 2)) - 2;
+
+        // Se busca la columna válida más cercana
+        while (!board.fits(shape, rot, x, 0) && x < Engine::BOARD_WIDTH) ++x;
+        if (!board.fits(shape, rot, x, 0)) {
+            board.clear();
+            ++resets;
+            continue;
+        }
+        int y = board.dropY(shape, rot, x, 0);
+        lines += board.lock(shape, rot, x, y);
+    }
+    double secs = Bench::nowSeconds() - t0;
+
+    std::printf("piezas: %ld  lineas: %ld  reinicios: %ld\n", pieces, lines, resets);
+    std::printf("%.4f s  (%.1f ns/pieza)\n", secs, secs * 1e9 / pieces);
+    return 0;
+}
@@ -0,0 +1,51 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+// Utilidades mínimas para los micro-benchmarks (C++98, sin dependencias).
+
+#include <iostream>
+
+#include "engine/log.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+namespace Bench {
+
+    // Reloj de pared en segundos con la mejor resolución disponible
+    inline double nowSeconds() {
+#ifdef _WIN32
+        LARGE_INTEGER freq, t;
+        QueryPerformanceFrequency(&freq);
+        QueryPerformanceCounter(&t);
+        return static_cast<double>(t.QuadPart) / static_cast<double>(freq.QuadPart);
+#else
+        timeval tv;
+        gettimeofday(&tv, NULL);
+        return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) * 1e-6;
+#endif
+    }
+
+    // Silencia std::cout y el registro del motor mientras dura el objeto
+    struct QuietStdout {
+        int level;
+        QuietStdout() : level(Engine::Log::level()) {
+            std::cout.setstate(std::ios_base::badbit);
+            Engine::Log::setLevel(LOG_LEVEL_OFF);
+        }
+        ~QuietStdout() {
+            Engine::Log::setLevel(level);
+            std::cout.clear();
+        }
+    };
+
+    // Evita que el compilador descarte resultados calculados en el bench
+    static volatile long gSink = 0;
+    inline void consume(long v) { gSink += v; }
+
+} // namespace Bench
+
+#endif // BENCH_UTIL_H
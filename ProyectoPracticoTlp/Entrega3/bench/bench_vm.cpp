@@ -0,0 +1,178 @@
+// Micro-benchmark: programas .brik aritméticos y con ciclos (bench/vm/*.astb,
+// generados con el analizador de Entrega1) ejecutados por
+//   - el evaluador de árbol (evaluator.h),
+//   - la máquina de registros sin optimizar (sin plegado ni invariantes),
+//   - la máquina de registros como la usa el intérprete.
+// Se corre el método "update" de cada programa y se reportan ms por
+// llamada, instrucciones ejecutadas y millones de instrucciones por
+// segundo. Las tres rutas deben dejar las mismas variables y el mismo
+// puntaje.
+//
+// Uso: bin/bench_vm [repeticiones] [programa.astb...]
+
+#include "interpreter/register_vm.h"
+#include "interpreter/ast_binary.h"
+#include "interpreter/mapped_file.h"
+#include "engine/world.h"
+#include "bench_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+// Estado de un programa cargado: variables, cadenas y mundo propios
+struct Instance {
+    std::vector<Eval::Value> slots;
+    std::vector<std::string> strings;
+    std::map<std::string, int> stringIndex;
+    Eval::RuntimeStrings runtime;
+    Eval::Slots names;
+    Engine::World world;
+    Eval::Context cx;
+
+    Instance() {
+        world.reset();
+        cx.world       = &world;
+        cx.slots       = &slots;
+        cx.strings     = &strings;
+        cx.stringIndex = &stringIndex;
+        cx.runtime     = &runtime;
+    }
+
+    // Atributos de la clase con su valor inicial, como loadBinaryFile
+    void initAttributes(const AstBin::View &ast, const Eval::Names &k) {
+        for (uint32_t i = 0; i < ast.nodeCount(); ++i) {
+            const AstBin::Node &n = ast.node(i);
+            if (n.type != k.attribute) continue;
+            Eval::Value v = Eval::initialValue(ast, k, i, names, cx);
+            cx.store(names.slotFor(ast.str(AstBin::View::prop(n, k.name)), slots), v);
+        }
+    }
+
+    // Variables en texto, para comparar las rutas (las que nunca se tocaron
+    // no cuentan: la máquina no crea slots para ramas que descartó)
+    std::string dump() {
+        char buf[32];
+        std::sprintf(buf, "score=%d", world.score());
+        std::string out = buf;
+        for (std::map<std::string, int>::iterator it = names.index.begin(); it != names.index.end(); ++it) {
+            if (slots[it->second].kind == Eval::NIL) continue;
+            out += " " + it->first + "=" + cx.text(slots[it->second]);
+        }
+        return out;
+    }
+};
+
+static uint32_t findUpdate(const AstBin::View &ast, const Eval::Names &k) {
+    for (uint32_t i = 0; i < ast.nodeCount(); ++i) {
+        const AstBin::Node &n = ast.node(i);
+        uint32_t name = AstBin::View::prop(n, k.name);
+        if (n.type == k.method && name != AstBin::NONE && std::strcmp(ast.str(name), "update") == 0) return i;
+    }
+    return AstBin::NONE;
+}
+
+struct Result {
+    double seconds;     // mejor llamada
+    long instrs;        // instrucciones por llamada (solo la máquina)
+    std::string state;
+};
+
+static Result runTree(const AstBin::View &ast, const Eval::Names &k, uint32_t method, int reps) {
+    Instance in;
+    in.initAttributes(ast, k);
+    Eval::Body *body = Eval::compileMethod(ast, k, method, in.names, in.cx);
+    Result r;
+    r.seconds = 1e30;
+    r.instrs = 0;
+    for (int i = 0; body && i < reps; ++i) {
+        double t0 = Bench::nowSeconds();
+        body->run(in.cx);
+        double t = Bench::nowSeconds() - t0;
+        if (t < r.seconds) r.seconds = t;
+    }
+    if (body) body->release();
+    r.state = in.dump();
+    return r;
+}
+
+static Result runVm(const AstBin::View &ast, const Eval::Names &k, uint32_t method, int reps,
+                    const Vm::Options &opts) {
+    Instance in;
+    in.initAttributes(ast, k);
+    Vm::Program *p = Vm::compile(ast, k, method, in.names, in.cx, opts);
+    Result r;
+    r.seconds = 1e30;
+    r.instrs = 0;
+    for (int i = 0; p && i < reps; ++i) {
+        double t0 = Bench::nowSeconds();
+        r.instrs = p->run(in.cx);
+        double t = Bench::nowSeconds() - t0;
+        if (t < r.seconds) r.seconds = t;
+    }
+    delete p;
+    r.state = in.dump();
+    return r;
+}
+
+int main(int argc, char **argv) {
+    int reps = argc >= 2 ? std::atoi(argv[1]) : 5;
+    std::vector<std::string> files;
+    for (int i = 2; i < argc; ++i) files.push_back(argv[i]);
+    if (files.empty()) {
+        files.push_back("bench/vm/arith.astb");
+        files.push_back("bench/vm/loops.astb");
+        files.push_back("bench/vm/invariant.astb");
+        files.push_back("bench/vm/logic.astb");
+    }
+
+    Vm::Options plain;
+    plain.fold  = false;
+    plain.hoist = false;
+
+    std::printf("mejor de %d llamadas a update\n", reps);
+    std::printf("%-24s %-12s %10s %12s %10s\n", "programa", "ruta", "ms", "instr", "Minstr/s");
+    bool allSame = true;
+    for (size_t f = 0; f < files.size(); ++f) {
+        MappedFile file;
+        AstBin::View ast;
+        std::string why;
+        if (!file.open(files[f]) || !ast.open(file.data(), file.size(), why)) {
+            std::fprintf(stderr, "no se pudo abrir %s\n", files[f].c_str());
+            return 1;
+        }
+        Eval::Names k;
+        k.find(ast);
+        uint32_t method = findUpdate(ast, k);
+        if (method == AstBin::NONE || !ast.validNode(method)) {
+            std::fprintf(stderr, "%s: sin metodo update\n", files[f].c_str());
+            return 1;
+        }
+
+        Result tree, raw, opt;
+        {
+            Bench::QuietStdout quiet;
+            tree = runTree(ast, k, method, reps);
+            raw  = runVm(ast, k, method, reps, plain);
+            opt  = runVm(ast, k, method, reps, Vm::Options());
+        }
+        const char *name = files[f].c_str();
+        const char *slash = std::strrchr(name, '/');
+        if (slash) name = slash + 1;
+        std::printf("%-24s %-12s %10.3f %12s %10s\n", name, "arbol", tree.seconds * 1000, "-", "-");
+        std::printf("%-24s %-12s %10.3f %12ld %10.1f  (x%.1f)\n", "", "vm sin opt", raw.seconds * 1000,
+                    raw.instrs, raw.instrs / raw.seconds / 1e6, tree.seconds / raw.seconds);
+        std::printf("%-24s %-12s %10.3f %12ld %10.1f  (x%.1f)\n", "", "vm", opt.seconds * 1000,
+                    opt.instrs, opt.instrs / opt.seconds / 1e6, tree.seconds / opt.seconds);
+        if (raw.state != tree.state || opt.state != tree.state) {
+            std::printf("  DISTINTO:\n    arbol: %s\n    vm sin opt: %s\n    vm: %s\n",
+                        tree.state.c_str(), raw.state.c_str(), opt.state.c_str());
+            allSame = false;
+        }
+    }
+    std::printf("estado final %s\n", allSame ? "igual en las tres rutas" : "DISTINTO");
+    return allSame ? 0 : 1;
+}
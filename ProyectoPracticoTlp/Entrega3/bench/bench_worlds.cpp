@@ -0,0 +1,88 @@
+// Micro-benchmark: escalado del lote de partidas headless según el número
+// de hilos (1, 2, 4, ... hasta un hilo por núcleo). Cada partida corre en
+// su propio Engine::World con una copia del intérprete ya cargado.
+//
+// Uso: bin/bench_worlds [partidas] [frames_por_partida] [script]
+
+#include "interpreter/script_interpreter.h"
+#include "engine/world.h"
+#include "engine/batch_runner.h"
+#include "engine/thread.h"
+#include "bench_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+struct Games {
+    const ScriptInterpreter* script;
+    int frames;
+    std::vector<long> framesRun;
+};
+
+static void playOne(int index, void* ctx) {
+    Games* g = static_cast<Games*>(ctx);
+    Engine::World world;
+    world.seed(1000u + static_cast<unsigned int>(index));
+    ScriptInterpreter interp(*g->script);
+    interp.bindWorld(world);
+
+    static const char keys[] = "wasd";
+    unsigned int lcg = 0x9E3779B9u ^ static_cast<unsigned int>(index);
+    interp.callMethod(Engine::intern("init"));
+    const Engine::Symbol update = Engine::intern("update");
+    int f = 0;
+    for (; f < g->frames && !world.isGameEnded(); ++f) {
+        lcg = lcg * 1664525u + 1013904223u;
+        if ((lcg >> 8) % 5 == 0) world.handleKey(keys[(lcg >> 16) & 3]);
+        interp.callMethod(update);
+    }
+    g->framesRun[index] = f;
+}
+
+int main(int argc, char** argv) {
+    int games  = argc >= 2 ? std::atoi(argv[1]) : 2000;
+    int frames = argc >= 3 ? std::atoi(argv[2]) : 2000;
+    std::string script = argc >= 4 ? argv[3] : "games/snake.script";
+
+    Bench::QuietStdout quiet;
+    ScriptInterpreter interp;
+    if (!interp.loadASTFile(script)) {
+        std::fprintf(stderr, "no se pudo cargar %s\n", script.c_str());
+        return 1;
+    }
+    interp.compileAll();
+
+    int cores = Engine::Thread::hardwareConcurrency();
+    std::vector<int> counts;
+    for (int t = 1; t < cores; t *= 2) counts.push_back(t);
+    counts.push_back(cores);
+
+    std::printf("%s: %d partidas x %d frames, %d nucleos\n", script.c_str(), games, frames, cores);
+    std::printf("%6s %10s %12s %14s %9s\n", "hilos", "segundos", "partidas/s", "frames/s", "speedup");
+
+    double base = 0.0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        Games g;
+        g.script = &interp;
+        g.frames = frames;
+        g.framesRun.assign(games, 0);
+
+        Engine::BatchRunner runner(counts[i]);
+        double t0 = Bench::nowSeconds();
+        runner.run(games, &playOne, &g);
+        double secs = Bench::nowSeconds() - t0;
+
+        long total = 0;
+        for (int k = 0; k < games; ++k) total += g.framesRun[k];
+        Bench::consume(total);
+        if (i == 0) base = secs;
+
+        std::printf("%6d %10.3f %12.0f %14.0f %8.2fx\n", counts[i], secs,
+                    secs > 0 ? games / secs : 0.0,
+                    secs > 0 ? total / secs : 0.0,
+                    secs > 0 ? base / secs : 0.0);
+    }
+    return 0;
+}
@@ -30,7 +30,22 @@ if not exist "%TARGET%" (
     "%GPP_EXE%" -std=gnu++98 -Wall -Isrc -Ithird_party ^
         %SRCDIR%\integration_main.cpp ^
         %SRCDIR%\engine\api.cpp ^
+        %SRCDIR%\engine\entity_store.cpp ^
+        %SRCDIR%\engine\snake_body.cpp ^
+        %SRCDIR%\engine\tetris_board.cpp ^
+        %SRCDIR%\engine\console_renderer.cpp ^
+        %SRCDIR%\engine\thread.cpp ^
+        %SRCDIR%\engine\log.cpp ^
+        %SRCDIR%\engine\symbols.cpp ^
+        %SRCDIR%\engine\frame_scheduler.cpp ^
+        %SRCDIR%\engine\input.cpp ^
+        %SRCDIR%\engine\input_log.cpp ^
+        %SRCDIR%\engine\world.cpp ^
+        %SRCDIR%\engine\batch_runner.cpp ^
         %SRCDIR%\interpreter\script_interpreter.cpp ^
+        %SRCDIR%\interpreter\mapped_file.cpp ^
+        %SRCDIR%\interpreter\evaluator.cpp ^
+        %SRCDIR%\interpreter\register_vm.cpp ^
         -o %TARGET%
     if errorlevel 1 (
         echo Error en la compilacion. Revise los mensajes anteriores.
@@ -5,6 +5,8 @@
 
 namespace Engine {
 
+    class InputLog;
+
     // Parámetros básicos del tablero
     const int TILE_SIZE    = 32;
     const int BOARD_WIDTH  = 10;   // 10 columnas
@@ -19,9 +21,12 @@ namespace Engine {
     // Inicialización / apagado del motor
     void initEngine();
     void shutdownEngine();
+    void seedRandom(unsigned int seed);   // semilla fija para partidas reproducibles
 
     // Loop principal
     bool pollEvents();      // Procesa eventos de consola (teclas)
+    bool handleKey(int key);   // Aplica una tecla como si viniera del teclado
+    void recordInput(InputLog* log);   // pollEvents() anota en log cada tecla que aplica (NULL: nada)
     void presentFrame();    // Dibuja el estado en texto
 
     // API principal que usa ahora el motor
@@ -30,6 +35,7 @@ namespace Engine {
     void setScore(int value);
     void addScore(int delta);
     bool isGameEnded();
+    unsigned long long stateHash();   // huella del estado para comparar corridas
 
     // --- WRAPPERS para mantener compatibilidad con el intérprete --------
     // El intérprete llama a estas versiones con Vec2, las redirigimos
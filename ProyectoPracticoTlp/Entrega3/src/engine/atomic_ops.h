@@ -0,0 +1,64 @@
+#ifndef ENGINE_ATOMIC_OPS_H
+#define ENGINE_ATOMIC_OPS_H
+
+// Operaciones atómicas mínimas para C++98: Interlocked* en Windows (XP ya
+// las trae) y las primitivas __sync de GCC en el resto.
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace Engine {
+
+    typedef volatile long AtomicLong;
+
+    inline void memoryBarrier() {
+#ifdef _WIN32
+        MemoryBarrier();
+#else
+        __sync_synchronize();
+#endif
+    }
+
+    // Con GCC >= 4.7 se usan las primitivas __atomic (las entienden los
+    // sanitizadores); con compiladores más viejos, lectura/escritura con barreras.
+    inline long atomicLoad(const AtomicLong* p) {
+#if defined(__ATOMIC_SEQ_CST) && !defined(_MSC_VER)
+        return __atomic_load_n(p, __ATOMIC_SEQ_CST);
+#else
+        long v = *p;
+        memoryBarrier();
+        return v;
+#endif
+    }
+
+    inline void atomicStore(AtomicLong* p, long v) {
+#if defined(__ATOMIC_SEQ_CST) && !defined(_MSC_VER)
+        __atomic_store_n(p, v, __ATOMIC_SEQ_CST);
+#else
+        memoryBarrier();
+        *p = v;
+        memoryBarrier();
+#endif
+    }
+
+    // Devuelve el valor anterior
+    inline long atomicAdd(AtomicLong* p, long delta) {
+#ifdef _WIN32
+        return InterlockedExchangeAdd(const_cast<LONG*>(reinterpret_cast<volatile LONG*>(p)), delta);
+#else
+        return __sync_fetch_and_add(p, delta);
+#endif
+    }
+
+    inline bool atomicCas(AtomicLong* p, long expected, long desired) {
+#ifdef _WIN32
+        return InterlockedCompareExchange(reinterpret_cast<volatile LONG*>(p), desired, expected) == expected;
+#else
+        return __sync_bool_compare_and_swap(p, expected, desired);
+#endif
+    }
+
+} // namespace Engine
+
+#endif // ENGINE_ATOMIC_OPS_H
@@ -0,0 +1,49 @@
+#include "engine/batch_runner.h"
+#include "engine/atomic_ops.h"
+#include "engine/thread.h"
+
+namespace Engine {
+
+    namespace {
+
+        struct BatchState {
+            AtomicLong next;
+            int        count;
+            BatchJob   job;
+            void*      ctx;
+        };
+
+        void workerMain(void* arg) {
+            BatchState* st = static_cast<BatchState*>(arg);
+            for (;;) {
+                long i = atomicAdd(&st->next, 1);
+                if (i >= st->count) return;
+                st->job(static_cast<int>(i), st->ctx);
+            }
+        }
+
+    } // namespace
+
+    BatchRunner::BatchRunner(int threads)
+        : threads_(threads > 0 ? threads : Thread::hardwareConcurrency()) {}
+
+    void BatchRunner::run(int count, BatchJob job, void* ctx) {
+        if (count <= 0) return;
+
+        BatchState st;
+        st.next  = 0;
+        st.count = count;
+        st.job   = job;
+        st.ctx   = ctx;
+
+        int extra = threads_ - 1;
+        if (extra > count - 1) extra = count - 1;
+
+        Thread* workers = extra > 0 ? new Thread[extra] : 0;
+        for (int i = 0; i < extra; ++i) workers[i].start(&workerMain, &st);
+        workerMain(&st);
+        for (int i = 0; i < extra; ++i) workers[i].join();
+        delete[] workers;
+    }
+
+} // namespace Engine
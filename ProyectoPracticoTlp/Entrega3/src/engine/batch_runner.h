@@ -0,0 +1,28 @@
+#ifndef ENGINE_BATCH_RUNNER_H
+#define ENGINE_BATCH_RUNNER_H
+
+namespace Engine {
+
+    typedef void (*BatchJob)(int index, void* ctx);
+
+    // Reparte 'count' trabajos independientes entre varios hilos. Cada hilo
+    // toma el siguiente índice con un incremento atómico, así los trabajos
+    // largos no dejan a otros hilos ociosos.
+    //
+    // Los hilos se crean al empezar cada lote y se esperan al final: XP no
+    // tiene variables de condición y crear un hilo cuesta microsegundos
+    // frente a los segundos que tarda un lote de partidas.
+    class BatchRunner {
+    public:
+        explicit BatchRunner(int threads = 0);   // 0 = un hilo por núcleo
+
+        int  threads() const { return threads_; }
+        void run(int count, BatchJob job, void* ctx);   // el hilo llamador también trabaja
+
+    private:
+        int threads_;
+    };
+
+} // namespace Engine
+
+#endif // ENGINE_BATCH_RUNNER_H
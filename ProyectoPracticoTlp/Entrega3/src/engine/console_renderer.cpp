@@ -0,0 +1,146 @@
+#include "engine/console_renderer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Engine {
+
+    // Celdas sin cambios entre dos tramos que conviene reescribir en vez de
+    // emitir otro movimiento de cursor (que ocupa unos 6-8 bytes).
+    static const int kMergeGap = 6;
+
+    ConsoleRenderer::ConsoleRenderer(int cols, int rows)
+        : cols_(cols), rows_(rows),
+          front_(cols * rows, ' '), back_(cols * rows, ' '),
+          needFull_(true), active_(false) {
+        stats_.frames    = 0;
+        stats_.bytes     = 0;
+        stats_.writes    = 0;
+        stats_.fullBytes = 0;
+        out_.reserve(cols * rows * 2 + 64);
+    }
+
+    void ConsoleRenderer::clear(char fill) {
+        std::memset(&back_[0], fill, back_.size());
+    }
+
+    void ConsoleRenderer::print(int x, int y, const char* text) {
+        for (; *text && x < cols_; ++text, ++x) put(x, y, *text);
+    }
+
+    void ConsoleRenderer::moveCursor(int x, int y) {
+        char buf[32];
+        int n = std::sprintf(buf, "\x1b[%d;%dH", y + 1, x + 1);
+        out_.append(buf, n);
+    }
+
+    void ConsoleRenderer::emitFull() {
+        char buf[32];
+        out_.append("\x1b[2J");
+        // Región de scroll para los mensajes: desde la fila siguiente al
+        // dibujo hasta el final de la pantalla.
+        int n = std::sprintf(buf, "\x1b[%dr", rows_ + 2);
+        out_.append(buf, n);
+        moveCursor(0, rows_ + 1);
+        out_.append("\x1b" "7");     // guarda el cursor en la zona de mensajes
+        for (int y = 0; y < rows_; ++y) {
+            moveCursor(0, y);
+            out_.append(&back_[y * cols_], cols_);
+        }
+        out_.append("\x1b" "8");
+        front_ = back_;
+        needFull_ = false;
+        active_   = true;
+    }
+
+    void ConsoleRenderer::emitDiff() {
+        bool any = false;
+        for (int y = 0; y < rows_; ++y) {
+            const char* f = &front_[y * cols_];
+            const char* b = &back_[y * cols_];
+            int x = 0;
+            while (x < cols_) {
+                if (f[x] == b[x]) { ++x; continue; }
+
+                // Tramo de cambios, uniendo huecos cortos sin cambios
+                int start = x;
+                int end   = x + 1;
+                int gap   = 0;
+                for (int i = end; i < cols_; ++i) {
+                    if (f[i] != b[i]) { end = i + 1; gap = 0; }
+                    else if (++gap > kMergeGap) break;
+                }
+
+                if (!any) {
+                    out_.append("\x1b" "7");
+                    any = true;
+                }
+                moveCursor(start, y);
+                out_.append(b + start, end - start);
+                x = end;
+            }
+        }
+        if (any) {
+            out_.append("\x1b" "8");
+            front_ = back_;
+        }
+    }
+
+    void ConsoleRenderer::flushOut() {
+        if (out_.empty()) return;
+
+        // Lo que el motor haya escrito por std::cout va antes que el frame
+        std::cout.flush();
+        std::fflush(stdout);
+#ifdef _WIN32
+        std::fwrite(out_.data(), 1, out_.size(), stdout);
+        std::fflush(stdout);
+#else
+        const char* p = out_.data();
+        size_t left = out_.size();
+        while (left > 0) {
+            ssize_t w = ::write(STDOUT_FILENO, p, left);
+            if (w <= 0) break;
+            p    += w;
+            left -= static_cast<size_t>(w);
+        }
+#endif
+        stats_.bytes  += static_cast<unsigned long>(out_.size());
+        stats_.writes += 1;
+    }
+
+    void ConsoleRenderer::present() {
+        out_.clear();
+        if (needFull_) emitFull();
+        else           emitDiff();
+        flushOut();
+
+        // Referencia: limpiar la pantalla y volver a escribir cada línea
+        unsigned long full = 7;   // "\x1b[2J\x1b[H"
+        for (int y = 0; y < rows_; ++y) {
+            int len = cols_;
+            while (len > 0 && back_[y * cols_ + len - 1] == ' ') --len;
+            full += static_cast<unsigned long>(len + 1);
+        }
+        stats_.frames    += 1;
+        stats_.fullBytes += full;
+    }
+
+    void ConsoleRenderer::shutdown() {
+        if (!active_) return;
+        out_.clear();
+        out_.append("\x1b[r");          // sin región de scroll (el cursor va al inicio)
+        out_.append("\x1b[999;1H\n");   // se sigue escribiendo al final de la pantalla
+        flushOut();
+        active_   = false;
+        needFull_ = true;
+    }
+
+} // namespace Engine
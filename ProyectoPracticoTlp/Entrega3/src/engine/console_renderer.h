@@ -0,0 +1,59 @@
+#ifndef ENGINE_CONSOLE_RENDERER_H
+#define ENGINE_CONSOLE_RENDERER_H
+
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+    // Contadores del renderizador de consola
+    struct RenderStats {
+        unsigned long frames;
+        unsigned long bytes;       // bytes enviados a la terminal
+        unsigned long writes;      // llamadas a write()
+        unsigned long fullBytes;   // lo que habría costado redibujar todo
+    };
+
+    // Renderizador de texto con doble búfer. Cada frame se compone en el
+    // búfer trasero y present() compara con el frame anterior: solo emite
+    // movimientos de cursor y caracteres de las celdas que cambiaron, todo
+    // en un único write().
+    //
+    // El primer frame limpia la pantalla y fija una región de scroll debajo
+    // del tablero; los mensajes de texto del motor se desplazan ahí sin
+    // mover el dibujo, y cada present() guarda y restaura el cursor.
+    class ConsoleRenderer {
+    public:
+        ConsoleRenderer(int cols, int rows);
+
+        void clear(char fill = ' ');
+        void put(int x, int y, char c) {
+            if (x >= 0 && x < cols_ && y >= 0 && y < rows_) back_[y * cols_ + x] = c;
+        }
+        void print(int x, int y, const char* text);
+
+        void present();
+        void invalidate() { needFull_ = true; }
+        void shutdown();    // restaura la región de scroll de la terminal
+
+        const RenderStats& stats() const { return stats_; }
+
+    private:
+        int cols_;
+        int rows_;
+        std::vector<char> front_;   // lo que hay en pantalla
+        std::vector<char> back_;    // lo que se está componiendo
+        std::string out_;           // bytes del frame (se reutiliza)
+        bool needFull_;
+        bool active_;
+        RenderStats stats_;
+
+        void moveCursor(int x, int y);
+        void emitFull();
+        void emitDiff();
+        void flushOut();
+    };
+
+} // namespace Engine
+
+#endif // ENGINE_CONSOLE_RENDERER_H
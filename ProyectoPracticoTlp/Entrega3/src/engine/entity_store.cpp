@@ -0,0 +1,134 @@
+#include "engine/entity_store.h"
+
+namespace Engine {
+
+    EntityStore::EntityStore() {
+        clear();
+    }
+
+    void EntityStore::clear() {
+        ids_.clear();
+        gx_.clear();
+        gy_.clear();
+        w_.clear();
+        h_.clear();
+        types_.clear();
+        denseSlot_.clear();
+        viewPos_.clear();
+        for (int k = 0; k < KIND_COUNT; ++k) views_[k].clear();
+        slots_.clear();
+        freeSlots_.clear();
+
+        // Slot 0 reservado: ningún id válido vale 0
+        Slot reserved;
+        reserved.dense      = -1;
+        reserved.generation = 0;
+        slots_.push_back(reserved);
+    }
+
+    void EntityStore::reserve(size_t n) {
+        ids_.reserve(n);
+        gx_.reserve(n);
+        gy_.reserve(n);
+        w_.reserve(n);
+        h_.reserve(n);
+        types_.reserve(n);
+        denseSlot_.reserve(n);
+        viewPos_.reserve(n);
+        slots_.reserve(n + 1);
+    }
+
+    // Las vistas se mantienen como la lista de celdas libres de la rejilla:
+    // agregar va al final y quitar trae el último al hueco
+    void EntityStore::viewAdd(int dense) {
+        std::vector<int> &v = views_[kindOfType(types_[dense])];
+        viewPos_[dense] = static_cast<int>(v.size());
+        v.push_back(dense);
+    }
+
+    void EntityStore::viewRemove(int dense) {
+        std::vector<int> &v = views_[kindOfType(types_[dense])];
+        int pos  = viewPos_[dense];
+        int last = v.back();
+        v[pos] = last;
+        viewPos_[last] = pos;
+        v.pop_back();
+    }
+
+    int EntityStore::create(Symbol type) {
+        int slot;
+        if (!freeSlots_.empty()) {
+            slot = freeSlots_.back();
+            freeSlots_.pop_back();
+        } else {
+            slot = static_cast<int>(slots_.size());
+            Slot s;
+            s.dense      = -1;
+            s.generation = 0;
+            slots_.push_back(s);
+        }
+
+        Slot &s = slots_[slot];
+        int dense = static_cast<int>(ids_.size());
+        s.dense = dense;
+
+        ids_.push_back((s.generation << SLOT_BITS) | slot);
+        gx_.push_back(0);
+        gy_.push_back(0);
+        w_.push_back(1);
+        h_.push_back(1);
+        types_.push_back(type);
+        denseSlot_.push_back(slot);
+        viewPos_.push_back(0);
+        viewAdd(dense);
+        return dense;
+    }
+
+    void EntityStore::setType(int i, Symbol t) {
+        if (kindOfType(t) == kindOfType(types_[i])) {
+            types_[i] = t;
+            return;
+        }
+        viewRemove(i);
+        types_[i] = t;
+        viewAdd(i);
+    }
+
+    bool EntityStore::remove(int id) {
+        int dense = indexOf(id);
+        if (dense < 0) return false;
+
+        int slot = id & SLOT_MASK;
+        int last = static_cast<int>(ids_.size()) - 1;
+        viewRemove(dense);
+
+        // El último elemento denso ocupa el hueco, también en su vista
+        if (dense != last) {
+            ids_[dense]       = ids_[last];
+            gx_[dense]        = gx_[last];
+            gy_[dense]        = gy_[last];
+            w_[dense]         = w_[last];
+            h_[dense]         = h_[last];
+            types_[dense]     = types_[last];
+            denseSlot_[dense] = denseSlot_[last];
+            viewPos_[dense]   = viewPos_[last];
+            slots_[denseSlot_[dense]].dense = dense;
+            views_[kindOfType(types_[dense])][viewPos_[dense]] = dense;
+        }
+        ids_.pop_back();
+        gx_.pop_back();
+        gy_.pop_back();
+        w_.pop_back();
+        h_.pop_back();
+        types_.pop_back();
+        denseSlot_.pop_back();
+        viewPos_.pop_back();
+
+        Slot &s = slots_[slot];
+        s.dense      = -1;
+        s.generation = (s.generation + 1) & GEN_MASK;
+        freeSlots_.push_back(slot);
+        return true;
+    }
+
+} // namespace Engine
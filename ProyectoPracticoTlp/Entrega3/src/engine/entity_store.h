@@ -0,0 +1,114 @@
+#ifndef ENGINE_ENTITY_STORE_H
+#define ENGINE_ENTITY_STORE_H
+
+#include "engine/symbols.h"
+
+#include <vector>
+#include <cstddef>
+
+namespace Engine {
+
+    // Clase de entidad según su tipo: cada sistema recorre solo la suya
+    enum EntityKind {
+        KIND_OTHER = 0,
+        KIND_TETRIS,     // piezas y bloques
+        KIND_SNAKE,      // cabeza y cuerpo
+        KIND_FOOD,
+        KIND_COUNT
+    };
+
+    inline int kindOfType(Symbol t) {
+        if (isTetrisType(t)) return KIND_TETRIS;
+        if (t == TYPE_SNAKE || t == TYPE_SNAKE_BODY) return KIND_SNAKE;
+        if (t == TYPE_FOOD) return KIND_FOOD;
+        return KIND_OTHER;
+    }
+
+    // Almacén de entidades tipo "slot map", con cada campo en su columna.
+    //
+    // - Las entidades viven en columnas densas y paralelas (id, posición,
+    //   tamaño, tipo): un recorrido lee solo los campos que usa, sin
+    //   arrastrar el resto del registro por la caché.
+    // - Cada entidad se nombra por su índice denso. Crear no mueve a las
+    //   demás, así que un índice vale hasta el siguiente borrado.
+    // - Cada id es un handle: (generación << SLOT_BITS) | slot. La tabla de
+    //   slots traduce el slot al índice denso, así que buscar y borrar
+    //   cuestan O(1).
+    // - Al borrar, el último elemento ocupa el hueco y la generación del slot
+    //   aumenta; un id viejo deja de ser válido aunque el slot se reutilice.
+    // - El slot 0 se reserva, de modo que los ids empiezan en 1 y, mientras
+    //   no haya borrados, son consecutivos como antes (1, 2, 3, ...).
+    // - El orden de iteración es el de inserción y solo cambia al borrar.
+    // - view(kind) da los índices densos de las entidades de una clase
+    //   (comida, serpiente, Tetris) para recorrerlas sin pasar por las demás.
+    class EntityStore {
+    public:
+        static const int SLOT_BITS = 21;                 // hasta ~2M entidades vivas
+        static const int SLOT_MASK = (1 << SLOT_BITS) - 1;
+        static const int GEN_MASK  = (1 << (31 - SLOT_BITS)) - 1;
+
+        EntityStore();
+
+        void clear();
+        void reserve(size_t n);
+
+        // Crea una entidad de 1x1 en (0,0) y devuelve su índice denso
+        int  create(Symbol type = TYPE_NONE);
+        bool remove(int id);
+
+        // Índice denso de un id, -1 si no existe
+        int indexOf(int id) const {
+            if (id <= 0) return -1;
+            int slot = id & SLOT_MASK;
+            if (slot >= static_cast<int>(slots_.size())) return -1;
+            const Slot &s = slots_[slot];
+            if (s.dense < 0 || s.generation != ((id >> SLOT_BITS) & GEN_MASK)) return -1;
+            return s.dense;
+        }
+        bool contains(int id) const { return indexOf(id) >= 0; }
+
+        size_t size() const { return ids_.size(); }
+        bool empty() const { return ids_.empty(); }
+
+        // Columnas, por índice denso
+        int    id(int i) const   { return ids_[i]; }
+        int&   gx(int i)         { return gx_[i]; }
+        int    gx(int i) const   { return gx_[i]; }
+        int&   gy(int i)         { return gy_[i]; }
+        int    gy(int i) const   { return gy_[i]; }
+        int&   w(int i)          { return w_[i]; }
+        int    w(int i) const    { return w_[i]; }
+        int&   h(int i)          { return h_[i]; }
+        int    h(int i) const    { return h_[i]; }
+        Symbol type(int i) const { return types_[i]; }
+        void   setType(int i, Symbol t);   // si cambia de clase, cambia de vista
+
+        // Índices densos de las entidades de una clase (KIND_*)
+        const std::vector<int>& view(int kind) const { return views_[kind]; }
+        size_t count(int kind) const { return views_[kind].size(); }
+
+    private:
+        struct Slot {
+            int dense;        // índice denso, -1 si el slot está libre
+            int generation;
+        };
+
+        std::vector<int>    ids_;
+        std::vector<int>    gx_;
+        std::vector<int>    gy_;
+        std::vector<int>    w_;
+        std::vector<int>    h_;
+        std::vector<Symbol> types_;
+        std::vector<int>    denseSlot_;   // slot dueño de cada elemento denso
+        std::vector<int>    viewPos_;     // posición de cada elemento en su vista
+        std::vector<int>    views_[KIND_COUNT];
+        std::vector<Slot>   slots_;
+        std::vector<int>    freeSlots_;
+
+        void viewAdd(int dense);
+        void viewRemove(int dense);
+    };
+
+} // namespace Engine
+
+#endif // ENGINE_ENTITY_STORE_H
@@ -0,0 +1,210 @@
+#include "engine/frame_scheduler.h"
+
+#include <cmath>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <errno.h>
+#include <time.h>
+#endif
+
+namespace Engine {
+
+    // ---------------------------------------------------------------------
+    // Reloj y espera
+    // ---------------------------------------------------------------------
+
+    long long monotonicNs() {
+#ifdef _WIN32
+        static LARGE_INTEGER freq;
+        if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+        LARGE_INTEGER t;
+        QueryPerformanceCounter(&t);
+        // En dos partes para no desbordar con frecuencias altas
+        long long s = t.QuadPart / freq.QuadPart;
+        long long r = t.QuadPart % freq.QuadPart;
+        return s * 1000000000LL + r * 1000000000LL / freq.QuadPart;
+#else
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return static_cast<long long>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+#endif
+    }
+
+    // Duerme hasta el instante t de monotonicNs() (puede despertar un poco después)
+    static void sleepUntil(long long t) {
+#ifdef _WIN32
+        // Sleep va en milisegundos y con la resolución del temporizador del
+        // sistema: se duerme de a tramos y el último milisegundo se cede
+        for (;;) {
+            long long left = t - monotonicNs();
+            if (left <= 0) return;
+            DWORD ms = static_cast<DWORD>(left / 1000000);
+            Sleep(ms > 1 ? ms - 1 : 0);
+        }
+#elif defined(TIMER_ABSTIME) && !defined(__APPLE__)
+        timespec ts;
+        ts.tv_sec  = static_cast<time_t>(t / 1000000000LL);
+        ts.tv_nsec = static_cast<long>(t % 1000000000LL);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {}
+#else
+        for (;;) {
+            long long left = t - monotonicNs();
+            if (left <= 0) return;
+            timespec ts;
+            ts.tv_sec  = static_cast<time_t>(left / 1000000000LL);
+            ts.tv_nsec = static_cast<long>(left % 1000000000LL);
+            nanosleep(&ts, NULL);
+        }
+#endif
+    }
+
+    // ---------------------------------------------------------------------
+    // Estadísticas
+    // ---------------------------------------------------------------------
+
+    static const long long kBucketLimitsUs[FrameStats::BUCKETS - 1] = {
+        10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000, 20000
+    };
+
+    long long FrameStats::bucketLimitUs(int b) {
+        return (b >= 0 && b < BUCKETS - 1) ? kBucketLimitsUs[b] : -1;
+    }
+
+    void FrameStats::clear() {
+        frames          = 0;
+        missed          = 0;
+        lateMaxNs       = 0;
+        lateSumNs       = 0;
+        intervalSumNs   = 0;
+        intervalSumSqNs = 0;
+        intervalMinNs   = -1;
+        intervalMaxNs   = 0;
+        for (int b = 0; b < BUCKETS; ++b) histogram[b] = 0;
+    }
+
+    void FrameStats::record(long long lateNs, long long intervalNs) {
+        ++frames;
+        lateSumNs += static_cast<double>(lateNs);
+        if (lateNs > lateMaxNs) lateMaxNs = lateNs;
+
+        int b = 0;
+        while (b < BUCKETS - 1 && lateNs >= kBucketLimitsUs[b] * 1000) ++b;
+        ++histogram[b];
+
+        if (intervalNs < 0) return;
+        double d = static_cast<double>(intervalNs);
+        if (intervalMinNs < 0 || intervalNs < intervalMinNs) intervalMinNs = intervalNs;
+        if (intervalNs > intervalMaxNs) intervalMaxNs = intervalNs;
+        intervalSumNs   += d;
+        intervalSumSqNs += d * d;
+    }
+
+    long long FrameStats::latePercentileUs(double p) const {
+        if (frames == 0) return 0;
+        long need = static_cast<long>(std::ceil(p / 100.0 * frames));
+        if (need < 1) need = 1;
+        long seen = 0;
+        for (int b = 0; b < BUCKETS - 1; ++b) {
+            seen += histogram[b];
+            if (seen >= need) return kBucketLimitsUs[b];
+        }
+        return lateMaxNs / 1000;
+    }
+
+    // Los intervalos empiezan en el segundo frame
+    double FrameStats::meanIntervalMs() const {
+        long n = frames - 1;
+        return n > 0 ? intervalSumNs / n / 1e6 : 0.0;
+    }
+
+    double FrameStats::jitterMs() const {
+        long n = frames - 1;
+        if (n <= 0) return 0.0;
+        double mean = intervalSumNs / n;
+        double var  = intervalSumSqNs / n - mean * mean;
+        return var > 0 ? std::sqrt(var) / 1e6 : 0.0;
+    }
+
+    // Los microsegundos caben en long (y %lld no lo entiende el msvcrt de
+    // MinGW). Cada texto entra en un mensaje de log.h.
+    std::string FrameStats::summary() const {
+        char buf[128];
+        std::sprintf(buf, "%ld frames, periodo %.3f ms, jitter %.3f ms (min %.3f, max %.3f), %ld perdidos",
+                     frames, meanIntervalMs(), jitterMs(),
+                     intervalMinNs < 0 ? 0.0 : intervalMinNs / 1e6, intervalMaxNs / 1e6, missed);
+        return buf;
+    }
+
+    std::string FrameStats::lateSummary() const {
+        char buf[128];
+        std::sprintf(buf, "retraso medio %.0f us, p50 <= %ld us, p99 <= %ld us, max %ld us",
+                     frames ? lateSumNs / frames / 1000 : 0.0,
+                     static_cast<long>(latePercentileUs(50)), static_cast<long>(latePercentileUs(99)),
+                     static_cast<long>(lateMaxNs / 1000));
+        return buf;
+    }
+
+    std::string FrameStats::histogramText() const {
+        std::string out;
+        char buf[32];
+        for (int b = 0; b < BUCKETS; ++b) {
+            if (histogram[b] == 0) continue;
+            if (b < BUCKETS - 1) std::sprintf(buf, " <%ld:%ld", static_cast<long>(kBucketLimitsUs[b]), histogram[b]);
+            else                 std::sprintf(buf, " >=%ld:%ld", static_cast<long>(kBucketLimitsUs[b - 1]), histogram[b]);
+            out += buf;
+        }
+        return out.empty() ? out : out.substr(1);
+    }
+
+    // ---------------------------------------------------------------------
+    // Planificador
+    // ---------------------------------------------------------------------
+
+    const long long FrameScheduler::DEFAULT_SPIN_NS;
+    const int       FrameScheduler::MAX_CATCH_UP;
+
+    FrameScheduler::FrameScheduler(long long stepNs, long long spinNs)
+        : step_(stepNs > 0 ? stepNs : 1), spin_(spinNs < 0 ? 0 : spinNs) {
+        reset();
+    }
+
+    void FrameScheduler::reset() {
+        long long now = monotonicNs();
+        simTime_  = now - step_;
+        deadline_ = now + step_;
+        lastWake_ = -1;
+        stats_.clear();
+    }
+
+    int FrameScheduler::advance() {
+        long long behind = monotonicNs() - simTime_;
+        if (behind < step_) return 0;
+        long long n = behind / step_;
+        simTime_ += n * step_;
+        return n > MAX_CATCH_UP ? MAX_CATCH_UP : static_cast<int>(n);
+    }
+
+    void FrameScheduler::waitForDeadline() {
+        long long now = monotonicNs();
+        if (now < deadline_) {
+            if (deadline_ - now > spin_) sleepUntil(deadline_ - spin_);
+            while ((now = monotonicNs()) < deadline_) {}
+        }
+
+        long long late = now - deadline_;
+        stats_.record(late, lastWake_ < 0 ? -1 : now - lastWake_);
+        lastWake_ = now;
+
+        // Más de un paso tarde (el frame fue muy largo): se sigue desde
+        // ahora en vez de encadenar frames sin espera para alcanzar
+        if (late > step_) {
+            ++stats_.missed;
+            deadline_ = now;
+        }
+        deadline_ += step_;
+    }
+
+} // namespace Engine
@@ -0,0 +1,95 @@
+#ifndef ENGINE_FRAME_SCHEDULER_H
+#define ENGINE_FRAME_SCHEDULER_H
+
+// Ritmo de frames con paso fijo sobre un reloj monotónico.
+//
+// Antes el bucle hacía el trabajo del frame y luego dormía ms_por_frame:
+// el frame duraba trabajo + espera, se atrasaba con la carga y el sleep
+// relativo sumaba su propio error. Aquí los deadlines son absolutos
+// (inicio + k * paso), así que el error de un frame no se arrastra al
+// siguiente, y la simulación avanza en pasos fijos con un acumulador:
+//
+//     FrameScheduler sched(16 * 1000000LL);
+//     while (jugando) {
+//         for (int n = sched.advance(); n > 0; --n) update();   // pasos que tocan
+//         render();
+//         sched.waitForDeadline();
+//     }
+//
+// La espera duerme hasta 'spin' nanosegundos antes del deadline
+// (clock_nanosleep con TIMER_ABSTIME; Sleep en Windows) y el resto lo hace
+// girando sobre el reloj. Cada despertar queda en FrameStats.
+//
+// No depende del resto del motor: Entrega2 lo usa tal cual.
+
+#include <string>
+
+namespace Engine {
+
+    // Nanosegundos de un reloj que no salta (CLOCK_MONOTONIC / QueryPerformanceCounter)
+    long long monotonicNs();
+
+    // Retraso de cada despertar respecto a su deadline (histograma) y
+    // estadísticas del intervalo entre frames: su desviación es el jitter.
+    struct FrameStats {
+        enum { BUCKETS = 12 };
+
+        long      frames;
+        long      missed;           // deadlines perdidos por más de un paso (se resincroniza)
+        long long lateMaxNs;
+        double    lateSumNs;
+        double    intervalSumNs;
+        double    intervalSumSqNs;
+        long long intervalMinNs;
+        long long intervalMaxNs;
+        long      histogram[BUCKETS];
+
+        FrameStats() { clear(); }
+        void clear();
+        void record(long long lateNs, long long intervalNs);   // intervalNs < 0: primer frame
+
+        static long long bucketLimitUs(int b);   // cota superior del cubo b (-1: sin cota)
+        long long latePercentileUs(double p) const;
+        double    meanIntervalMs() const;
+        double    jitterMs() const;              // desviación estándar del intervalo
+
+        std::string summary() const;             // frames, periodo y jitter
+        std::string lateSummary() const;         // retraso medio, p50, p99 y máximo
+        std::string histogramText() const;       // cubos no vacíos en us: "<10:3 <20:40 ..."
+    };
+
+    class FrameScheduler {
+    public:
+        static const long long DEFAULT_SPIN_NS = 200000;   // último tramo girando
+        static const int       MAX_CATCH_UP    = 5;        // pasos máximos por frame al atrasarse
+
+        explicit FrameScheduler(long long stepNs, long long spinNs = DEFAULT_SPIN_NS);
+
+        // Vuelve a empezar: el primer advance() devuelve 1 paso y el primer
+        // deadline queda un paso después de ahora
+        void reset();
+
+        // Pasos de simulación que corresponden al tiempo transcurrido (0 o
+        // más; si hay más de MAX_CATCH_UP atrasados se descarta el resto)
+        int  advance();
+
+        // Duerme hasta el deadline del próximo frame y lo registra
+        void waitForDeadline();
+
+        long long stepNs() const { return step_; }
+        long long spinNs() const { return spin_; }
+        void setSpinNs(long long ns) { spin_ = ns < 0 ? 0 : ns; }
+        const FrameStats& stats() const { return stats_; }
+
+    private:
+        long long step_;
+        long long spin_;
+        long long deadline_;     // próximo despertar
+        long long simTime_;      // hasta dónde llegó la simulación
+        long long lastWake_;     // -1 antes del primer frame
+        FrameStats stats_;
+    };
+
+} // namespace Engine
+
+#endif // ENGINE_FRAME_SCHEDULER_H
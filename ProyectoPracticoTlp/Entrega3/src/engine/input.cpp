@@ -0,0 +1,179 @@
+#include "engine/input.h"
+#include "engine/frame_scheduler.h"
+
+#include <cmath>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <conio.h>
+#else
+#include <errno.h>
+#include <unistd.h>
+#include <sys/select.h>
+#endif
+
+namespace Engine {
+
+    // ---------------------------------------------------------------------
+    // Hilo lector
+    // ---------------------------------------------------------------------
+
+    InputReader::InputReader() : fd_(-1), stop_(0), eof_(0) {
+        wake_[0] = wake_[1] = -1;
+    }
+
+    InputReader::~InputReader() {
+        stop();
+    }
+
+    bool InputReader::start(int fd) {
+        if (thread_.running()) return true;
+        fd_ = fd;
+        atomicStore(&stop_, 0);
+        atomicStore(&eof_, 0);
+#ifndef _WIN32
+        if (pipe(wake_) != 0) {
+            wake_[0] = wake_[1] = -1;
+            return false;
+        }
+#endif
+        if (thread_.start(&InputReader::threadMain, this)) return true;
+#ifndef _WIN32
+        close(wake_[0]);
+        close(wake_[1]);
+        wake_[0] = wake_[1] = -1;
+#endif
+        return false;
+    }
+
+    void InputReader::stop() {
+        if (!thread_.running()) return;
+        atomicStore(&stop_, 1);
+#ifndef _WIN32
+        char c = 0;
+        ssize_t n = write(wake_[1], &c, 1);
+        (void)n;
+#endif
+        thread_.join();
+#ifndef _WIN32
+        close(wake_[0]);
+        close(wake_[1]);
+        wake_[0] = wake_[1] = -1;
+#endif
+    }
+
+    void InputReader::threadMain(void* self) {
+        static_cast<InputReader*>(self)->run();
+    }
+
+#ifdef _WIN32
+    // La consola no entra en un select: se espera a que tenga eventos (con
+    // tope, para ver stop_) y se sacan las teclas que haya
+    void InputReader::run() {
+        HANDLE in = GetStdHandle(STD_INPUT_HANDLE);
+        while (!atomicLoad(&stop_)) {
+            if (WaitForSingleObject(in, 50) != WAIT_OBJECT_0) continue;
+            bool any = false;
+            while (_kbhit()) {
+                KeyEvent e;
+                e.key    = _getch();
+                e.timeNs = monotonicNs();
+                queue_.push(e);
+                any = true;
+            }
+            if (!any) Sleep(1);   // eventos que no son teclas (foco, ratón)
+        }
+    }
+#else
+    void InputReader::run() {
+        const int maxFd = fd_ > wake_[0] ? fd_ : wake_[0];
+        for (;;) {
+            fd_set fds;
+            FD_ZERO(&fds);
+            FD_SET(fd_, &fds);
+            FD_SET(wake_[0], &fds);
+            if (select(maxFd + 1, &fds, NULL, NULL, NULL) < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            if (FD_ISSET(wake_[0], &fds) || atomicLoad(&stop_)) break;
+
+            unsigned char buf[64];
+            ssize_t n = read(fd_, buf, sizeof(buf));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {   // fin de la entrada (p. ej. < /dev/null)
+                atomicStore(&eof_, 1);
+                break;
+            }
+            long long now = monotonicNs();
+            for (ssize_t i = 0; i < n; ++i) {
+                KeyEvent e;
+                e.key    = buf[i];
+                e.timeNs = now;
+                queue_.push(e);
+            }
+        }
+    }
+#endif
+
+    // ---------------------------------------------------------------------
+    // Estadísticas
+    // ---------------------------------------------------------------------
+
+    static const long long kBucketLimitsUs[InputStats::BUCKETS - 1] = {
+        100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000
+    };
+
+    long long InputStats::bucketLimitUs(int b) {
+        return (b >= 0 && b < BUCKETS - 1) ? kBucketLimitsUs[b] : -1;
+    }
+
+    void InputStats::clear() {
+        keys         = 0;
+        maxBatch     = 0;
+        latencySumNs = 0;
+        latencyMaxNs = 0;
+        for (int b = 0; b < BUCKETS; ++b) histogram[b] = 0;
+    }
+
+    void InputStats::record(long long latencyNs) {
+        ++keys;
+        latencySumNs += static_cast<double>(latencyNs);
+        if (latencyNs > latencyMaxNs) latencyMaxNs = latencyNs;
+
+        int b = 0;
+        while (b < BUCKETS - 1 && latencyNs >= kBucketLimitsUs[b] * 1000) ++b;
+        ++histogram[b];
+    }
+
+    void InputStats::recordBatch(long n) {
+        if (n > maxBatch) maxBatch = n;
+    }
+
+    long long InputStats::latencyPercentileUs(double p) const {
+        if (keys == 0) return 0;
+        long need = static_cast<long>(std::ceil(p / 100.0 * keys));
+        if (need < 1) need = 1;
+        long seen = 0;
+        int b = 0;
+        for (; b < BUCKETS - 1; ++b) {
+            seen += histogram[b];
+            if (seen >= need) break;
+        }
+        // Cota del cubo, sin pasarse del máximo visto
+        long long maxUs = latencyMaxNs / 1000;
+        return (b < BUCKETS - 1 && kBucketLimitsUs[b] < maxUs) ? kBucketLimitsUs[b] : maxUs;
+    }
+
+    // Entra en un mensaje de log.h (ver FrameStats::summary)
+    std::string InputStats::summary() const {
+        char buf[128];
+        std::sprintf(buf, "entrada: %ld teclas, latencia media %.0f us, p99 <= %ld us, max %ld us, hasta %ld juntas",
+                     keys, keys ? latencySumNs / keys / 1000 : 0.0,
+                     static_cast<long>(latencyPercentileUs(99)),
+                     static_cast<long>(latencyMaxNs / 1000), maxBatch);
+        return buf;
+    }
+
+} // namespace Engine
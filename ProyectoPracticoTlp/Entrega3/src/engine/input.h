@@ -0,0 +1,121 @@
+#ifndef ENGINE_INPUT_H
+#define ENGINE_INPUT_H
+
+// Lectura del teclado en un hilo aparte.
+//
+// Antes pollEvents() hacía un select() por frame y consumía a lo sumo una
+// tecla: las que llegaban entre frames esperaban un frame entero cada una
+// y cada consulta era una llamada al sistema dentro del bucle del juego.
+// Ahora InputReader bloquea en la entrada (select sobre el descriptor y un
+// pipe para despertarlo al parar; WaitForSingleObject en Windows), marca
+// cada tecla con monotonicNs() y la deja en un anillo sin bloqueos de un
+// productor y un consumidor. El bucle saca todo lo pendiente sin llamar al
+// sistema, y InputStats mide cuánto tardó cada tecla en llegar a la
+// simulación.
+
+#include "engine/atomic_ops.h"
+#include "engine/thread.h"
+
+#include <string>
+
+namespace Engine {
+
+    struct KeyEvent {
+        int       key;
+        long long timeNs;   // monotonicNs() al leerla
+    };
+
+    // Anillo acotado de un productor (el hilo lector) y un consumidor (el
+    // bucle del juego). Cada extremo solo escribe su propio índice; los
+    // índices van en líneas de caché distintas. Si está lleno la tecla se
+    // descarta y se cuenta.
+    class KeyQueue {
+    public:
+        enum { CAPACITY = 256 };   // potencia de dos
+
+        KeyQueue() : head_(0), tail_(0), dropped_(0) {}
+
+        bool push(const KeyEvent& e) {
+            long t = atomicLoad(&tail_);
+            if (t - atomicLoad(&head_) == CAPACITY) {
+                atomicAdd(&dropped_, 1);
+                return false;
+            }
+            items_[t & (CAPACITY - 1)] = e;
+            atomicStore(&tail_, t + 1);   // publica la tecla
+            return true;
+        }
+
+        bool pop(KeyEvent& e) {
+            long h = atomicLoad(&head_);
+            if (h == atomicLoad(&tail_)) return false;
+            e = items_[h & (CAPACITY - 1)];
+            atomicStore(&head_, h + 1);   // libera la celda
+            return true;
+        }
+
+        unsigned long dropped() const { return static_cast<unsigned long>(atomicLoad(&dropped_)); }
+
+    private:
+        KeyEvent   items_[CAPACITY];
+        AtomicLong head_;
+        char       padHead_[64];
+        AtomicLong tail_;
+        char       padTail_[64];
+        AtomicLong dropped_;
+    };
+
+    class InputReader {
+    public:
+        InputReader();
+        ~InputReader();
+
+        // Lanza el hilo que lee 'fd' (en Windows se lee la consola con
+        // _getch y fd no se usa). Devuelve false si no pudo lanzarlo.
+        bool start(int fd);
+        void stop();                 // despierta al hilo y espera que termine
+        bool running() const { return thread_.running(); }
+        bool atEof() const   { return atomicLoad(&eof_) != 0; }
+
+        bool pop(KeyEvent& e)        { return queue_.pop(e); }
+        unsigned long dropped() const { return queue_.dropped(); }
+
+    private:
+        KeyQueue   queue_;
+        Thread     thread_;
+        int        fd_;
+        int        wake_[2];         // pipe para despertar al lector (POSIX)
+        AtomicLong stop_;
+        AtomicLong eof_;
+
+        static void threadMain(void* self);
+        void run();
+
+        InputReader(const InputReader&);
+        InputReader& operator=(const InputReader&);
+    };
+
+    // Latencia desde que se leyó cada tecla hasta que la aplicó el bucle
+    struct InputStats {
+        enum { BUCKETS = 12 };
+
+        long      keys;
+        long      maxBatch;         // más teclas sacadas en una consulta
+        double    latencySumNs;
+        long long latencyMaxNs;
+        long      histogram[BUCKETS];
+
+        InputStats() { clear(); }
+        void clear();
+        void record(long long latencyNs);
+        void recordBatch(long n);
+
+        static long long bucketLimitUs(int b);   // cota superior del cubo b (-1: sin cota)
+        long long latencyPercentileUs(double p) const;
+
+        std::string summary() const;             // teclas, latencia media, p99 y máximo
+    };
+
+} // namespace Engine
+
+#endif // ENGINE_INPUT_H
@@ -0,0 +1,120 @@
+#include "engine/input_log.h"
+
+#include <cstdio>
+
+namespace Engine {
+
+    const unsigned char InputLog::VERSION;
+
+    static const char kMagic[4] = { 'B', 'K', 'E', 'Y' };
+
+    static void putInt(std::string& out, unsigned long long v, int bytes) {
+        for (int i = 0; i < bytes; ++i) out += static_cast<char>((v >> (i * 8)) & 0xFF);
+    }
+
+    static void putVarint(std::string& out, unsigned int v) {
+        while (v >= 0x80) {
+            out += static_cast<char>((v & 0x7F) | 0x80);
+            v >>= 7;
+        }
+        out += static_cast<char>(v);
+    }
+
+    // Lector acotado: cualquier lectura fuera del archivo lo marca como corrupto
+    struct Reader {
+        const std::string& data;
+        size_t pos;
+        bool ok;
+
+        explicit Reader(const std::string& d) : data(d), pos(0), ok(true) {}
+
+        unsigned long long getInt(int bytes) {
+            if (pos + bytes > data.size()) { ok = false; return 0; }
+            unsigned long long v = 0;
+            for (int i = 0; i < bytes; ++i) {
+                v |= static_cast<unsigned long long>(static_cast<unsigned char>(data[pos++])) << (i * 8);
+            }
+            return v;
+        }
+
+        unsigned int getVarint() {
+            unsigned int v = 0;
+            for (int shift = 0; shift < 35; shift += 7) {
+                if (pos >= data.size()) break;
+                unsigned char b = static_cast<unsigned char>(data[pos++]);
+                v |= static_cast<unsigned int>(b & 0x7F) << shift;
+                if (!(b & 0x80)) return v;
+            }
+            ok = false;
+            return 0;
+        }
+    };
+
+    bool InputLog::save(const std::string& path) const {
+        std::string out(kMagic, 4);
+        putInt(out, VERSION, 1);
+        putInt(out, seed, 4);
+        putInt(out, static_cast<unsigned int>(frames), 4);
+        putInt(out, hash, 8);
+        putInt(out, events.size(), 4);
+        size_t len = script.size() < 0xFFFF ? script.size() : 0xFFFF;
+        putInt(out, len, 2);
+        out.append(script, 0, len);
+
+        int last = 0;
+        for (size_t i = 0; i < events.size(); ++i) {
+            putVarint(out, static_cast<unsigned int>(events[i].first - last));
+            out += static_cast<char>(events[i].second);
+            last = events[i].first;
+        }
+
+        FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f) return false;
+        bool ok = std::fwrite(out.data(), 1, out.size(), f) == out.size();
+        return std::fclose(f) == 0 && ok;
+    }
+
+    bool InputLog::load(const std::string& path) {
+        FILE* f = std::fopen(path.c_str(), "rb");
+        if (!f) return false;
+        std::string data;
+        char buf[4096];
+        size_t n;
+        while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) data.append(buf, n);
+        std::fclose(f);
+
+        if (data.size() < 4 || data.compare(0, 4, kMagic, 4) != 0) return false;
+        Reader r(data);
+        r.pos = 4;
+        if (r.getInt(1) != VERSION) return false;
+        unsigned int       s   = static_cast<unsigned int>(r.getInt(4));
+        int                fr  = static_cast<int>(r.getInt(4));
+        unsigned long long h   = r.getInt(8);
+        unsigned long long cnt = r.getInt(4);
+        size_t             len = static_cast<size_t>(r.getInt(2));
+        // Cada evento ocupa al menos 2 bytes: así un conteo corrupto no reserva de más
+        if (!r.ok || fr < 0 || r.pos + len > data.size() || cnt > (data.size() - r.pos - len) / 2) return false;
+        std::string name = data.substr(r.pos, len);
+        r.pos += len;
+
+        std::vector< std::pair<int,int> > evs;
+        evs.reserve(static_cast<size_t>(cnt));
+        long long frame = 0;
+        for (unsigned long long i = 0; i < cnt && r.ok; ++i) {
+            frame += r.getVarint();
+            int key = static_cast<int>(r.getInt(1));
+            if (frame > fr) r.ok = false;
+            evs.push_back(std::make_pair(static_cast<int>(frame), key));
+        }
+        if (!r.ok || r.pos != data.size()) return false;
+
+        seed   = s;
+        frames = fr;
+        hash   = h;
+        script.swap(name);
+        events.swap(evs);
+        frame_ = 0;
+        return true;
+    }
+
+} // namespace Engine
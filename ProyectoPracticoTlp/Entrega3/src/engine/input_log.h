@@ -0,0 +1,48 @@
+#ifndef ENGINE_INPUT_LOG_H
+#define ENGINE_INPUT_LOG_H
+
+// Grabación de las teclas de una partida (.keys) para repetirla.
+//
+// Con la semilla del motor y las teclas con su frame, una partida se
+// vuelve a simular igual en modo headless, a toda velocidad, y se compara
+// la huella final con la grabada: los benchmarks corren siempre la misma
+// carga. Formato binario, little-endian:
+//
+//   "BKEY" | versión u8 | semilla u32 | frames u32 | huella u64
+//          | teclas u32 | largo del script u16 | script | eventos
+//
+// Cada evento es la distancia en frames al anterior (varint de 7 bits por
+// byte) y la tecla (u8): una partida típica ocupa ~2 bytes por tecla.
+
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace Engine {
+
+    class InputLog {
+    public:
+        static const unsigned char VERSION = 1;
+
+        InputLog() : seed(0), frames(0), hash(0), frame_(0) {}
+
+        unsigned int       seed;     // semilla del motor
+        int                frames;   // frames simulados
+        unsigned long long hash;     // stateHash() al terminar
+        std::string        script;   // programa con que se grabó
+        std::vector< std::pair<int,int> > events;   // (frame, tecla), en orden
+
+        // Las teclas que lleguen con add() quedan en este frame
+        void beginFrame(int frame) { frame_ = frame; }
+        void add(int key) { events.push_back(std::make_pair(frame_, key & 0xFF)); }
+
+        bool save(const std::string& path) const;
+        bool load(const std::string& path);   // false si no existe o está corrupto
+
+    private:
+        int frame_;
+    };
+
+} // namespace Engine
+
+#endif // ENGINE_INPUT_LOG_H
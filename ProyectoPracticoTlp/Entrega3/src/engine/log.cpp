@@ -0,0 +1,235 @@
+#include "engine/log.h"
+#include "engine/atomic_ops.h"
+#include "engine/thread.h"
+
+#include <cstring>
+
+namespace Engine {
+namespace Log {
+
+    namespace {
+
+        // Anillo acotado multi-productor / un consumidor (esquema de Vyukov):
+        // cada celda lleva un número de secuencia que indica si está libre
+        // para el productor de la vuelta actual o lista para el consumidor.
+        const long RING_SIZE = 1024;          // potencia de dos
+        const long RING_MASK = RING_SIZE - 1;
+        const int  FLUSH_INTERVAL_MS = 10;
+
+        struct Record {
+            AtomicLong seq;
+            int  level;
+            int  category;
+            int  len;
+            char text[MAX_MESSAGE];
+        };
+
+        Record     gRing[RING_SIZE];
+        AtomicLong gEnqueuePos = 0;
+        AtomicLong gDequeuePos = 0;
+        AtomicLong gDropped    = 0;
+        AtomicLong gLevel      = LOG_COMPILE_LEVEL;
+        AtomicLong gConsumer   = 0;           // cerrojo de giro del consumidor
+        AtomicLong gRunning    = 0;
+        bool       gRingReady  = false;
+
+        FILE*  gSink = 0;
+        Thread gFlusher;
+
+        const char* const kCategoryTag[CAT_COUNT] = {
+            "[Engine] ",
+            "[Interpreter] "
+        };
+
+        void initRing() {
+            if (gRingReady) return;
+            for (long i = 0; i < RING_SIZE; ++i) gRing[i].seq = i;
+            gRingReady = true;
+        }
+
+        struct RingInit {
+            RingInit() { initRing(); }
+        };
+        RingInit gRingInit;
+
+        bool enqueue(int level, int category, const char* text, int len) {
+            long pos = atomicLoad(&gEnqueuePos);
+            for (;;) {
+                Record& r = gRing[pos & RING_MASK];
+                long seq = atomicLoad(&r.seq);
+                long diff = seq - pos;
+                if (diff == 0) {
+                    if (atomicCas(&gEnqueuePos, pos, pos + 1)) {
+                        r.level    = level;
+                        r.category = category;
+                        r.len      = len;
+                        std::memcpy(r.text, text, len);
+                        atomicStore(&r.seq, pos + 1);
+                        return true;
+                    }
+                    pos = atomicLoad(&gEnqueuePos);
+                } else if (diff < 0) {
+                    return false;   // lleno
+                } else {
+                    pos = atomicLoad(&gEnqueuePos);
+                }
+            }
+        }
+
+        void appendOut(char* out, int& used, int cap, const char* s, int n) {
+            if (used + n > cap) n = cap - used;
+            std::memcpy(out + used, s, n);
+            used += n;
+        }
+
+        // Saca todo lo pendiente y lo escribe con un único fwrite por tanda
+        void drain() {
+            if (!atomicCas(&gConsumer, 0, 1)) return;   // otro hilo ya drena
+
+            FILE* out = gSink ? gSink : stdout;
+            char  batch[8192];
+            int   used = 0;
+            const int lineMax = MAX_MESSAGE + 32;
+
+            for (;;) {
+                long pos = gDequeuePos;
+                Record& r = gRing[pos & RING_MASK];
+                if (atomicLoad(&r.seq) != pos + 1) break;   // vacío
+
+                if (used + lineMax > static_cast<int>(sizeof(batch))) {
+                    std::fwrite(batch, 1, used, out);
+                    used = 0;
+                }
+                const char* tag = kCategoryTag[r.category];
+                appendOut(batch, used, sizeof(batch), tag, static_cast<int>(std::strlen(tag)));
+                if (r.level == LOG_LEVEL_WARN)  appendOut(batch, used, sizeof(batch), "aviso: ", 7);
+                if (r.level == LOG_LEVEL_ERROR) appendOut(batch, used, sizeof(batch), "error: ", 7);
+                appendOut(batch, used, sizeof(batch), r.text, r.len);
+                appendOut(batch, used, sizeof(batch), "\n", 1);
+
+                atomicStore(&r.seq, pos + RING_SIZE);
+                gDequeuePos = pos + 1;
+            }
+            if (used > 0) {
+                std::fwrite(batch, 1, used, out);
+                std::fflush(out);
+            }
+            atomicStore(&gConsumer, 0);
+        }
+
+        void flusherMain(void*) {
+            while (atomicLoad(&gRunning)) {
+                drain();
+                Thread::sleepMs(FLUSH_INTERVAL_MS);
+            }
+            drain();
+        }
+
+        // Si el programa termina sin Log::stop(), el hilo de volcado seguiría
+        // en su bucle y el destructor de gFlusher lo esperaría para siempre.
+        // Este objeto se construye después de gFlusher, así que se destruye
+        // antes y lo detiene.
+        struct FlusherGuard {
+            ~FlusherGuard() { stop(); }
+        };
+        FlusherGuard gFlusherGuard;
+
+    } // namespace
+
+    // ---- Line ----
+
+    Line::Line(int level, int category)
+        : level_(level), category_(category), len_(0) {}
+
+    Line::~Line() {
+        if (!enqueue(level_, category_, text_, len_)) {
+            atomicAdd(&gDropped, 1);
+        }
+    }
+
+    void Line::append(const char* s, int n) {
+        if (len_ + n > MAX_MESSAGE) n = MAX_MESSAGE - len_;   // se trunca
+        if (n <= 0) return;
+        std::memcpy(text_ + len_, s, n);
+        len_ += n;
+    }
+
+    void Line::appendUnsigned(unsigned long long v, bool negative) {
+        char buf[24];
+        int i = sizeof(buf);
+        do {
+            buf[--i] = static_cast<char>('0' + v % 10);
+            v /= 10;
+        } while (v != 0);
+        if (negative) buf[--i] = '-';
+        append(buf + i, static_cast<int>(sizeof(buf)) - i);
+    }
+
+    Line& Line::operator<<(const char* s) {
+        if (s) append(s, static_cast<int>(std::strlen(s)));
+        return *this;
+    }
+    Line& Line::operator<<(const std::string& s) {
+        append(s.data(), static_cast<int>(s.size()));
+        return *this;
+    }
+    Line& Line::operator<<(char c) { append(&c, 1); return *this; }
+    Line& Line::operator<<(bool b) { return *this << (b ? "1" : "0"); }
+    Line& Line::operator<<(int v) { return *this << static_cast<long long>(v); }
+    Line& Line::operator<<(unsigned int v) { return *this << static_cast<unsigned long long>(v); }
+    Line& Line::operator<<(long v) { return *this << static_cast<long long>(v); }
+    Line& Line::operator<<(unsigned long v) { return *this << static_cast<unsigned long long>(v); }
+
+    Line& Line::operator<<(long long v) {
+        if (v < 0) appendUnsigned(0ULL - static_cast<unsigned long long>(v), true);
+        else       appendUnsigned(static_cast<unsigned long long>(v), false);
+        return *this;
+    }
+    Line& Line::operator<<(unsigned long long v) {
+        appendUnsigned(v, false);
+        return *this;
+    }
+    Line& Line::operator<<(double v) {
+        char buf[32];
+        int n = std::sprintf(buf, "%g", v);
+        append(buf, n);
+        return *this;
+    }
+
+    // ---- control ----
+
+    void setLevel(int lvl) { atomicStore(&gLevel, lvl); }
+    int  level()           { return static_cast<int>(gLevel); }
+
+    void setSink(FILE* out) {
+        flush();
+        gSink = out;
+    }
+
+    void start() {
+        initRing();
+        if (gFlusher.running()) return;
+        atomicStore(&gRunning, 1);
+        if (!gFlusher.start(&flusherMain, 0)) {
+            atomicStore(&gRunning, 0);   // sin hilo: se vacía en flush()/stop()
+        }
+    }
+
+    void stop() {
+        atomicStore(&gRunning, 0);
+        gFlusher.join();
+        drain();
+    }
+
+    void flush() {
+        // Si el hilo de volcado está drenando, se espera a que termine
+        while (atomicLoad(&gConsumer)) Thread::sleepMs(0);
+        drain();
+    }
+
+    unsigned long dropped() {
+        return static_cast<unsigned long>(atomicLoad(&gDropped));
+    }
+
+} // namespace Log
+} // namespace Engine
@@ -0,0 +1,122 @@
+#ifndef ENGINE_LOG_H
+#define ENGINE_LOG_H
+
+#include <string>
+#include <cstdio>
+
+// Registro de mensajes del motor y del intérprete.
+//
+// - Niveles: por debajo de LOG_COMPILE_LEVEL las macros no generan código.
+// - Encima del umbral, el mensaje se arma en un búfer fijo (sin memoria
+//   dinámica) y se encola en un anillo sin bloqueos; un hilo aparte lo
+//   escribe en la salida. El bucle del juego nunca espera por E/S.
+// - Si el anillo está lleno el mensaje se descarta y se cuenta.
+//
+// Uso:  LOG_INFO(ENGINE, "addScore " << delta << " => " << score);
+
+#define LOG_LEVEL_TRACE 0
+#define LOG_LEVEL_DEBUG 1
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_WARN  3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_OFF   5
+
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_LEVEL_INFO
+#endif
+
+namespace Engine {
+namespace Log {
+
+    enum Category {
+        CAT_ENGINE = 0,
+        CAT_INTERPRETER,
+        CAT_COUNT
+    };
+
+    const int MAX_MESSAGE = 116;   // bytes de texto por mensaje
+
+    // Mensaje en construcción; se encola al destruirse
+    class Line {
+    public:
+        Line(int level, int category);
+        ~Line();
+
+        Line& operator<<(const char* s);
+        Line& operator<<(const std::string& s);
+        Line& operator<<(char c);
+        Line& operator<<(bool b);
+        Line& operator<<(int v);
+        Line& operator<<(unsigned int v);
+        Line& operator<<(long v);
+        Line& operator<<(unsigned long v);
+        Line& operator<<(long long v);
+        Line& operator<<(unsigned long long v);
+        Line& operator<<(double v);
+
+    private:
+        int  level_;
+        int  category_;
+        int  len_;
+        char text_[MAX_MESSAGE];
+
+        void append(const char* s, int n);
+        void appendUnsigned(unsigned long long v, bool negative);
+
+        Line(const Line&);
+        Line& operator=(const Line&);
+    };
+
+    // Filtro en tiempo de ejecución (además del de compilación)
+    void setLevel(int level);
+    int  level();
+    inline bool enabled(int lvl) { return lvl >= level(); }
+
+    void setSink(FILE* out);       // por defecto stdout
+    void start();                  // lanza el hilo de volcado (idempotente)
+    void stop();                   // vacía lo pendiente y detiene el hilo
+    void flush();                  // vacía lo pendiente ahora mismo
+    unsigned long dropped();       // mensajes descartados por anillo lleno
+
+} // namespace Log
+} // namespace Engine
+
+#define LOG_AT(lvl, cat, expr) \
+    do { \
+        if (::Engine::Log::enabled(lvl)) { \
+            ::Engine::Log::Line logLine_(lvl, ::Engine::Log::CAT_##cat); \
+            logLine_ << expr; \
+        } \
+    } while (0)
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_TRACE
+#define LOG_TRACE(cat, expr) LOG_AT(LOG_LEVEL_TRACE, cat, expr)
+#else
+#define LOG_TRACE(cat, expr) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(cat, expr) LOG_AT(LOG_LEVEL_DEBUG, cat, expr)
+#else
+#define LOG_DEBUG(cat, expr) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(cat, expr) LOG_AT(LOG_LEVEL_INFO, cat, expr)
+#else
+#define LOG_INFO(cat, expr) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(cat, expr) LOG_AT(LOG_LEVEL_WARN, cat, expr)
+#else
+#define LOG_WARN(cat, expr) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(cat, expr) LOG_AT(LOG_LEVEL_ERROR, cat, expr)
+#else
+#define LOG_ERROR(cat, expr) ((void)0)
+#endif
+
+#endif // ENGINE_LOG_H
@@ -0,0 +1,126 @@
+#ifndef ENGINE_OCCUPANCY_GRID_H
+#define ENGINE_OCCUPANCY_GRID_H
+
+#include <vector>
+#include <cstddef>
+
+namespace Engine {
+
+    // Qué ocupa una celda del tablero
+    enum CellKind {
+        CELL_EMPTY = 0,
+        CELL_SNAKE_HEAD,
+        CELL_SNAKE_BODY,
+        CELL_FOOD
+    };
+
+    struct Cell {
+        int id;     // id de la entidad (0 si está vacía)
+        int kind;   // CellKind
+    };
+
+    // Rejilla de ocupación ancho x alto: una lectura de arreglo por consulta
+    // de colisión. Cada celda guarda una sola entidad; si dos se solapan gana
+    // la última escrita, y clearIf() solo borra si la celda sigue siendo de
+    // esa entidad, para no pisar a la otra.
+    //
+    // Además lleva el conjunto de celdas vacías: un arreglo de índices y la
+    // posición de cada celda en él. Ocupar una celda la saca con un
+    // intercambio con la última y liberarla la agrega al final, así que
+    // elegir una celda libre al azar cuesta lo mismo con el tablero vacío
+    // que casi lleno.
+    class OccupancyGrid {
+    public:
+        OccupancyGrid() : width_(0), height_(0) {}
+        OccupancyGrid(int width, int height) { reset(width, height); }
+
+        void reset(int width, int height) {
+            width_  = width;
+            height_ = height;
+            Cell empty;
+            empty.id   = 0;
+            empty.kind = CELL_EMPTY;
+            size_t n = static_cast<size_t>(width) * height;
+            cells_.assign(n, empty);
+            free_.resize(n);
+            slot_.resize(n);
+            for (size_t i = 0; i < n; ++i) {
+                free_[i] = static_cast<int>(i);
+                slot_[i] = static_cast<int>(i);
+            }
+        }
+
+        void clear() { reset(width_, height_); }
+
+        int width()  const { return width_; }
+        int height() const { return height_; }
+
+        bool inBounds(int x, int y) const {
+            return x >= 0 && x < width_ && y >= 0 && y < height_;
+        }
+
+        // Fuera del tablero se comporta como celda vacía
+        int kindAt(int x, int y) const {
+            return inBounds(x, y) ? cells_[index(x, y)].kind : CELL_EMPTY;
+        }
+        int idAt(int x, int y) const {
+            return inBounds(x, y) ? cells_[index(x, y)].id : 0;
+        }
+
+        void set(int x, int y, int id, int kind) {
+            if (!inBounds(x, y)) return;
+            size_t i = index(x, y);
+            Cell &c = cells_[i];
+            if (c.kind == CELL_EMPTY && kind != CELL_EMPTY) takeFree(i);
+            else if (c.kind != CELL_EMPTY && kind == CELL_EMPTY) releaseFree(i);
+            c.id   = id;
+            c.kind = kind;
+        }
+
+        void clearIf(int x, int y, int id) {
+            if (!inBounds(x, y)) return;
+            size_t i = index(x, y);
+            Cell &c = cells_[i];
+            if (c.id != id) return;
+            if (c.kind != CELL_EMPTY) releaseFree(i);
+            c.id   = 0;
+            c.kind = CELL_EMPTY;
+        }
+
+        // Celdas vacías: freeCell(k) da la k-ésima, k en [0, freeCount())
+        int freeCount() const { return static_cast<int>(free_.size()); }
+        void freeCell(int k, int& x, int& y) const {
+            int i = free_[k];
+            x = i % width_;
+            y = i / width_;
+        }
+
+    private:
+        int width_;
+        int height_;
+        std::vector<Cell> cells_;
+        std::vector<int>  free_;   // índices de las celdas vacías, sin orden
+        std::vector<int>  slot_;   // posición de cada celda en free_ (-1: ocupada)
+
+        size_t index(int x, int y) const {
+            return static_cast<size_t>(y) * width_ + x;
+        }
+
+        void takeFree(size_t i) {
+            int k    = slot_[i];
+            int last = free_.back();
+            free_[k]    = last;
+            slot_[last] = k;
+            free_.pop_back();
+            slot_[i] = -1;
+        }
+
+        void releaseFree(size_t i) {
+            slot_[i] = static_cast<int>(free_.size());
+            free_.push_back(static_cast<int>(i));
+        }
+    };
+
+} // namespace Engine
+
+#endif // ENGINE_OCCUPANCY_GRID_H
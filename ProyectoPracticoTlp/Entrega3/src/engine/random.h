@@ -0,0 +1,56 @@
+#ifndef ENGINE_RANDOM_H
+#define ENGINE_RANDOM_H
+
+// Generador PCG32 (O'Neill, pcg-random.org): 64 bits de estado, salida de
+// 32 bits con buena calidad estadística y un par de operaciones por número.
+// Reemplaza al LCG de rand() (15 bits útiles, bits bajos con periodo
+// corto) y al "% n", que favorecía a los primeros valores. Con la misma
+// semilla da la misma secuencia en cualquier plataforma.
+
+namespace Engine {
+
+    class Pcg32 {
+    public:
+        explicit Pcg32(unsigned long long seed = 1) { this->seed(seed); }
+
+        // Inicialización de referencia de pcg32_srandom_r con un flujo fijo
+        void seed(unsigned long long s) {
+            state_ = 0;
+            next();
+            state_ += s;
+            next();
+        }
+
+        unsigned int next() {
+            unsigned long long old = state_;
+            state_ = old * 6364136223846793005ULL + kIncrement;
+            unsigned int xorshifted = static_cast<unsigned int>(((old >> 18) ^ old) >> 27);
+            unsigned int rot = static_cast<unsigned int>(old >> 59);
+            return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+        }
+
+        // Uniforme en [0, n) sin sesgo (multiplicación de Lemire con rechazo)
+        unsigned int below(unsigned int n) {
+            if (n == 0) return 0;
+            unsigned long long m = static_cast<unsigned long long>(next()) * n;
+            unsigned int low = static_cast<unsigned int>(m);
+            if (low < n) {
+                unsigned int threshold = (0u - n) % n;
+                while (low < threshold) {
+                    m   = static_cast<unsigned long long>(next()) * n;
+                    low = static_cast<unsigned int>(m);
+                }
+            }
+            return static_cast<unsigned int>(m >> 32);
+        }
+
+        unsigned long long state() const { return state_; }
+
+    private:
+        static const unsigned long long kIncrement = 1442695040888963407ULL;   // flujo (impar)
+        unsigned long long state_;
+    };
+
+} // namespace Engine
+
+#endif // ENGINE_RANDOM_H
@@ -0,0 +1,77 @@
+#ifndef ENGINE_RING_BUFFER_H
+#define ENGINE_RING_BUFFER_H
+
+#include <vector>
+#include <cstddef>
+
+namespace Engine {
+
+    // Cola circular de doble extremo. La capacidad es potencia de dos y solo
+    // crece (duplicándose) cuando se llena; en régimen estable empujar y
+    // sacar por cualquiera de los dos extremos no reserva memoria.
+    template <typename T>
+    class RingBuffer {
+    public:
+        RingBuffer() : head_(0), size_(0) {}
+        explicit RingBuffer(size_t capacity) : head_(0), size_(0) { reserve(capacity); }
+
+        void clear() { head_ = 0; size_ = 0; }
+
+        void reserve(size_t capacity) {
+            if (capacity <= buf_.size()) return;
+            size_t cap = buf_.empty() ? 8 : buf_.size();
+            while (cap < capacity) cap *= 2;
+            regrow(cap);
+        }
+
+        size_t size() const     { return size_; }
+        bool   empty() const    { return size_ == 0; }
+        size_t capacity() const { return buf_.size(); }
+
+        // i = 0 es el frente
+        T&       operator[](size_t i)       { return buf_[(head_ + i) & mask()]; }
+        const T& operator[](size_t i) const { return buf_[(head_ + i) & mask()]; }
+
+        T&       front()       { return buf_[head_]; }
+        const T& front() const { return buf_[head_]; }
+        T&       back()        { return (*this)[size_ - 1]; }
+        const T& back() const  { return (*this)[size_ - 1]; }
+
+        void push_front(const T& v) {
+            if (size_ == buf_.size()) reserve(size_ + 1);
+            head_ = (head_ + buf_.size() - 1) & mask();
+            buf_[head_] = v;
+            ++size_;
+        }
+
+        void push_back(const T& v) {
+            if (size_ == buf_.size()) reserve(size_ + 1);
+            buf_[(head_ + size_) & mask()] = v;
+            ++size_;
+        }
+
+        void pop_front() {
+            head_ = (head_ + 1) & mask();
+            --size_;
+        }
+
+        void pop_back() { --size_; }
+
+    private:
+        std::vector<T> buf_;
+        size_t head_;
+        size_t size_;
+
+        size_t mask() const { return buf_.size() - 1; }
+
+        void regrow(size_t cap) {
+            std::vector<T> next(cap);
+            for (size_t i = 0; i < size_; ++i) next[i] = (*this)[i];
+            buf_.swap(next);
+            head_ = 0;
+        }
+    };
+
+} // namespace Engine
+
+#endif // ENGINE_RING_BUFFER_H
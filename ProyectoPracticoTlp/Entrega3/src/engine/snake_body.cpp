@@ -0,0 +1,49 @@
+#include "engine/snake_body.h"
+#include "engine/entity_store.h"
+#include "engine/occupancy_grid.h"
+
+namespace Engine {
+
+    void SnakeBody::reset(int headId) {
+        ids_.clear();
+        ids_.push_back(headId);
+    }
+
+    void SnakeBody::step(EntityStore& store, OccupancyGrid& grid, int x, int y, int newSegmentId) {
+        if (ids_.empty()) return;
+
+        int head = store.indexOf(ids_.front());
+        if (head < 0) return;
+        int headId = store.id(head);
+        int oldX = store.gx(head);
+        int oldY = store.gy(head);
+
+        // El segmento que pasa a ir detrás de la cabeza: uno nuevo si crece,
+        // si no la cola (cuando hay cuerpo).
+        int movedId = newSegmentId;
+        if (movedId == 0 && ids_.size() > 1) {
+            movedId = ids_.back();
+            ids_.pop_back();
+            int tail = store.indexOf(movedId);
+            if (tail >= 0) grid.clearIf(store.gx(tail), store.gy(tail), movedId);
+        }
+
+        grid.clearIf(oldX, oldY, headId);
+        store.gx(head) = x;
+        store.gy(head) = y;
+        grid.set(x, y, headId, CELL_SNAKE_HEAD);
+
+        if (movedId != 0) {
+            int seg = store.indexOf(movedId);
+            if (seg >= 0) {
+                store.gx(seg) = oldX;
+                store.gy(seg) = oldY;
+                grid.set(oldX, oldY, movedId, CELL_SNAKE_BODY);
+            }
+            ids_.pop_front();
+            ids_.push_front(movedId);
+            ids_.push_front(headId);
+        }
+    }
+
+} // namespace Engine
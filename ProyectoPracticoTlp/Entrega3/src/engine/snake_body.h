@@ -0,0 +1,38 @@
+#ifndef ENGINE_SNAKE_BODY_H
+#define ENGINE_SNAKE_BODY_H
+
+#include "engine/ring_buffer.h"
+
+namespace Engine {
+
+    class EntityStore;
+    class OccupancyGrid;
+
+    // Cuerpo de la serpiente como cola circular de ids, de la cabeza a la
+    // cola. Un paso no recorre los segmentos: la cabeza avanza y la cola
+    // salta a la celda que dejó la cabeza (o, si come, un segmento nuevo
+    // ocupa esa celda). Cuesta O(1) sin importar la longitud.
+    class SnakeBody {
+    public:
+        void clear() { ids_.clear(); }
+        void reset(int headId);
+        void pushTail(int id) { ids_.push_back(id); }   // para armar un cuerpo ya colocado
+
+        size_t length() const { return ids_.size(); }
+        bool   empty() const  { return ids_.empty(); }
+        int    headId() const { return ids_.front(); }
+        int    tailId() const { return ids_.back(); }
+        int    operator[](size_t i) const { return ids_[i]; }
+
+        // Mueve la cabeza a (x,y) y actualiza la rejilla. newSegmentId es una
+        // entidad ya creada que ocupa la celda vieja de la cabeza cuando la
+        // serpiente crece; 0 si no crece.
+        void step(EntityStore& store, OccupancyGrid& grid, int x, int y, int newSegmentId);
+
+    private:
+        RingBuffer<int> ids_;
+    };
+
+} // namespace Engine
+
+#endif // ENGINE_SNAKE_BODY_H
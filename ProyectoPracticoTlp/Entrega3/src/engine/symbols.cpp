@@ -0,0 +1,68 @@
+#include "engine/symbols.h"
+#include "engine/atomic_ops.h"
+#include "engine/thread.h"
+
+#include <deque>
+#include <map>
+
+namespace Engine {
+
+    namespace {
+
+        const char* const kFixedNames[FIXED_SYMBOLS] = {
+            "",
+            "I", "O", "T", "L", "J", "S", "Z",
+            "Tetris", "Block",
+            "Snake", "SnakeBody", "Food",
+            "spawnBlock", "moveEntity", "rotateEntity", "dropEntity",
+            "addScore", "setScore", "endGame", "drawText"
+        };
+
+        // Se crean con el primer uso y no se destruyen: así nadie depende del
+        // orden de construcción de los estáticos. Un deque no mueve sus
+        // elementos al crecer, así que los c_str() que se entregan siguen
+        // valiendo.
+        AtomicLong gLock = 0;
+        std::map<std::string, Symbol>* gIndex = NULL;
+        std::deque<std::string>*       gNames = NULL;   // a partir de FIXED_SYMBOLS
+
+        // Candado de giro, como el consumidor del registro: la tabla se toca
+        // casi solo al cargar programas
+        struct TableLock {
+            TableLock() {
+                while (!atomicCas(&gLock, 0, 1)) Thread::sleepMs(0);
+                if (!gIndex) {
+                    gIndex = new std::map<std::string, Symbol>();
+                    gNames = new std::deque<std::string>();
+                    for (int i = 0; i < FIXED_SYMBOLS; ++i) (*gIndex)[kFixedNames[i]] = i;
+                }
+            }
+            ~TableLock() { atomicStore(&gLock, 0); }
+        };
+
+    } // namespace
+
+    Symbol intern(const std::string& name) {
+        TableLock lock;
+        std::map<std::string, Symbol>::iterator it = gIndex->find(name);
+        if (it != gIndex->end()) return it->second;
+        Symbol s = FIXED_SYMBOLS + static_cast<Symbol>(gNames->size());
+        gNames->push_back(name);
+        (*gIndex)[name] = s;
+        return s;
+    }
+
+    Symbol findSymbol(const std::string& name) {
+        TableLock lock;
+        std::map<std::string, Symbol>::const_iterator it = gIndex->find(name);
+        return it == gIndex->end() ? NO_SYMBOL : it->second;
+    }
+
+    const char* symbolName(Symbol s) {
+        if (s >= 0 && s < FIXED_SYMBOLS) return kFixedNames[s];
+        TableLock lock;
+        size_t i = static_cast<size_t>(s - FIXED_SYMBOLS);
+        return (s >= FIXED_SYMBOLS && i < gNames->size()) ? (*gNames)[i].c_str() : "";
+    }
+
+} // namespace Engine
@@ -0,0 +1,41 @@
+#ifndef ENGINE_SYMBOLS_H
+#define ENGINE_SYMBOLS_H
+
+// Tabla global de símbolos: cada nombre (tipo de entidad, comando del motor,
+// método de un script) se interna una vez y desde ahí es un entero pequeño
+// que se compara con ==. Los tipos de entidad y los comandos tienen número
+// fijo; el resto se numera en orden de llegada a partir de FIXED_SYMBOLS.
+//
+// intern() y findSymbol() toman un candado (se usan al cargar y compilar);
+// symbolName() de un símbolo fijo no lo toma.
+
+#include <string>
+
+namespace Engine {
+
+    typedef int Symbol;
+
+    const Symbol NO_SYMBOL = -1;   // findSymbol() de un nombre nunca internado
+
+    enum FixedSymbol {
+        TYPE_NONE = 0,                                         // ""
+        // Tipos de entidad; las piezas en el orden de TetrominoShape
+        TYPE_I, TYPE_O, TYPE_T, TYPE_L, TYPE_J, TYPE_S, TYPE_Z,
+        TYPE_TETRIS, TYPE_BLOCK,                               // piden una pieza al azar
+        TYPE_SNAKE, TYPE_SNAKE_BODY, TYPE_FOOD,
+        // Comandos del motor, en el orden de OpCode
+        CMD_SPAWN_BLOCK, CMD_MOVE_ENTITY, CMD_ROTATE_ENTITY, CMD_DROP_ENTITY,
+        CMD_ADD_SCORE, CMD_SET_SCORE, CMD_END_GAME, CMD_DRAW_TEXT,
+        FIXED_SYMBOLS
+    };
+
+    Symbol      intern(const std::string& name);
+    Symbol      findSymbol(const std::string& name);   // NO_SYMBOL si no existe
+    const char* symbolName(Symbol s);                  // "" si no existe
+
+    inline bool isTetrisType(Symbol t)   { return t >= TYPE_I && t <= TYPE_BLOCK; }
+    inline bool isTetrominoType(Symbol t) { return t >= TYPE_I && t <= TYPE_Z; }
+
+} // namespace Engine
+
+#endif // ENGINE_SYMBOLS_H
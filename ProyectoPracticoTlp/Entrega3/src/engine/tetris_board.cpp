@@ -0,0 +1,123 @@
+#include "engine/tetris_board.h"
+
+namespace Engine {
+
+    // ---------------------------------------------------------------------
+    // Tabla de piezas
+    // ---------------------------------------------------------------------
+
+    // Rotación 0 de cada pieza (filas de la caja, bit 0 = columna izquierda)
+    // y el tamaño de la caja en la que gira.
+    static const unsigned int kBaseRows[SHAPE_COUNT][4] = {
+        { 0x0, 0xF, 0x0, 0x0 },   // I  ....  ####
+        { 0x3, 0x3, 0x0, 0x0 },   // O  ##    ##
+        { 0x2, 0x7, 0x0, 0x0 },   // T  .#.   ###
+        { 0x4, 0x7, 0x0, 0x0 },   // L  ..#   ###
+        { 0x1, 0x7, 0x0, 0x0 },   // J  #..   ###
+        { 0x6, 0x3, 0x0, 0x0 },   // S  .##   ##.
+        { 0x3, 0x6, 0x0, 0x0 }    // Z  ##.   .##
+    };
+    static const int kBoxSize[SHAPE_COUNT] = { 4, 2, 3, 3, 3, 3, 3 };
+
+    static PieceMask gMasks[SHAPE_COUNT][4];
+
+    // Gira la caja n x n en sentido horario: (fila r, col c) -> (c, n-1-r)
+    static PieceMask rotateClockwise(const PieceMask& in, int n) {
+        PieceMask out;
+        for (int r = 0; r < 4; ++r) out.rows[r] = 0;
+        for (int r = 0; r < n; ++r) {
+            for (int c = 0; c < n; ++c) {
+                if ((in.rows[r] >> c) & 1u) out.rows[c] |= 1u << (n - 1 - r);
+            }
+        }
+        return out;
+    }
+
+    // Se rellena antes de main(), así las consultas no llevan comprobaciones
+    struct MaskTableInit {
+        MaskTableInit() {
+            for (int s = 0; s < SHAPE_COUNT; ++s) {
+                for (int r = 0; r < 4; ++r) gMasks[s][0].rows[r] = kBaseRows[s][r];
+                for (int rot = 1; rot < 4; ++rot) {
+                    gMasks[s][rot] = rotateClockwise(gMasks[s][rot - 1], kBoxSize[s]);
+                }
+            }
+        }
+    };
+    static MaskTableInit gMaskTableInit;
+
+    const PieceMask& pieceMask(int shape, int rotation) {
+        return gMasks[shape][rotation & 3];
+    }
+
+    int shapeFromType(Symbol type) {
+        return isTetrominoType(type) ? type - TYPE_I : -1;
+    }
+
+    const char* shapeName(int shape) {
+        return (shape >= 0 && shape < SHAPE_COUNT) ? symbolName(TYPE_I + shape) : "?";
+    }
+
+    // ---------------------------------------------------------------------
+    // Tablero
+    // ---------------------------------------------------------------------
+
+    void TetrisBoard::reset(int width, int height) {
+        width_  = width;
+        height_ = height;
+        full_   = (width >= 32) ? 0xFFFFFFFFu : ((1u << width) - 1u);
+        rows_.assign(height, 0u);
+    }
+
+    bool TetrisBoard::fits(int shape, int rotation, int x, int y) const {
+        const PieceMask& m = pieceMask(shape, rotation);
+        for (int r = 0; r < 4; ++r) {
+            unsigned int bits = m.rows[r];
+            if (!bits) continue;
+
+            unsigned int shifted;
+            if (x >= 0) {
+                if (x >= 32) return false;
+                shifted = bits << x;
+                if ((shifted >> x) != bits) return false;   // se salió por la derecha
+            } else {
+                if (-x >= 4 || (bits & ((1u << -x) - 1u))) return false;   // pared izquierda
+                shifted = bits >> -x;
+            }
+            if (shifted & ~full_) return false;
+
+            int py = y + r;
+            if (py >= height_) return false;
+            if (py >= 0 && (rows_[py] & shifted)) return false;
+        }
+        return true;
+    }
+
+    int TetrisBoard::dropY(int shape, int rotation, int x, int y) const {
+        while (fits(shape, rotation, x, y + 1)) ++y;
+        return y;
+    }
+
+    int TetrisBoard::lock(int shape, int rotation, int x, int y) {
+        const PieceMask& m = pieceMask(shape, rotation);
+        for (int r = 0; r < 4; ++r) {
+            int py = y + r;
+            if (!m.rows[r] || py < 0 || py >= height_) continue;
+            rows_[py] |= (x >= 0) ? (m.rows[r] << x) : (m.rows[r] >> -x);
+        }
+        return clearLines();
+    }
+
+    int TetrisBoard::clearLines() {
+        // Compacta de abajo hacia arriba saltando las filas completas
+        int write = height_ - 1;
+        for (int read = height_ - 1; read >= 0; --read) {
+            if (rows_[read] == full_) continue;
+            rows_[write--] = rows_[read];
+        }
+        int cleared = write + 1;
+        for (; write >= 0; --write) rows_[write] = 0u;
+        return cleared;
+    }
+
+} // namespace Engine
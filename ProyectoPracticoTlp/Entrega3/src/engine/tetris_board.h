@@ -0,0 +1,76 @@
+#ifndef ENGINE_TETRIS_BOARD_H
+#define ENGINE_TETRIS_BOARD_H
+
+#include "engine/symbols.h"
+
+#include <vector>
+
+namespace Engine {
+
+    // Tetrominós estándar
+    enum TetrominoShape {
+        SHAPE_I = 0,
+        SHAPE_O,
+        SHAPE_T,
+        SHAPE_L,
+        SHAPE_J,
+        SHAPE_S,
+        SHAPE_Z,
+        SHAPE_COUNT
+    };
+
+    // Máscaras de una pieza en una caja de 4x4: fila r, bit c = celda
+    // (x + c, y + r) respecto a la esquina superior izquierda de la caja.
+    struct PieceMask {
+        unsigned int rows[4];
+    };
+
+    // Las 4 rotaciones de cada pieza (sentido horario), calculadas una vez.
+    const PieceMask& pieceMask(int shape, int rotation);
+    int  shapeFromType(Symbol type);   // -1 si no es un tetrominó
+    const char* shapeName(int shape);
+
+    // Tablero de Tetris como una máscara de bits por fila (bit x = columna x).
+    // Las colisiones son un AND de la pieza con cada fila que toca y una fila
+    // está completa cuando su máscara es igual a fullRow(); así colocar una
+    // pieza no recorre celdas sueltas. Admite hasta 32 columnas.
+    class TetrisBoard {
+    public:
+        TetrisBoard() : width_(0), height_(0), full_(0) {}
+        TetrisBoard(int width, int height) { reset(width, height); }
+
+        void reset(int width, int height);
+        void clear() { rows_.assign(height_, 0u); }
+
+        int width() const  { return width_; }
+        int height() const { return height_; }
+        unsigned int row(int y) const { return rows_[y]; }
+        unsigned int fullRow() const  { return full_; }
+
+        bool filled(int x, int y) const {
+            if (x < 0 || x >= width_ || y < 0 || y >= height_) return false;
+            return (rows_[y] >> x) & 1u;
+        }
+
+        // ¿Cabe la pieza con su caja en (x,y)? Las filas por encima del
+        // tablero cuentan como vacías; los lados y el fondo, como pared.
+        bool fits(int shape, int rotation, int x, int y) const;
+
+        // y más bajo alcanzable dejando caer la pieza desde (x,y)
+        int dropY(int shape, int rotation, int x, int y) const;
+
+        // Fija la pieza y elimina las filas completas; devuelve cuántas.
+        int lock(int shape, int rotation, int x, int y);
+
+    private:
+        int width_;
+        int height_;
+        unsigned int full_;
+        std::vector<unsigned int> rows_;   // fila 0 arriba
+
+        int clearLines();
+    };
+
+} // namespace Engine
+
+#endif // ENGINE_TETRIS_BOARD_H
@@ -0,0 +1,77 @@
+#include "engine/thread.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace Engine {
+
+    Thread::Thread() : running_(false), fn_(0), arg_(0) {
+#ifdef _WIN32
+        handle_ = NULL;
+#endif
+    }
+
+    Thread::~Thread() {
+        join();
+    }
+
+#ifdef _WIN32
+    DWORD WINAPI Thread::trampoline(LPVOID self) {
+        Thread* t = static_cast<Thread*>(self);
+        t->fn_(t->arg_);
+        return 0;
+    }
+#else
+    void* Thread::trampoline(void* self) {
+        Thread* t = static_cast<Thread*>(self);
+        t->fn_(t->arg_);
+        return NULL;
+    }
+#endif
+
+    bool Thread::start(ThreadFunc fn, void* arg) {
+        if (running_) return false;
+        fn_  = fn;
+        arg_ = arg;
+#ifdef _WIN32
+        handle_ = CreateThread(NULL, 0, &Thread::trampoline, this, 0, NULL);
+        running_ = (handle_ != NULL);
+#else
+        running_ = (pthread_create(&handle_, NULL, &Thread::trampoline, this) == 0);
+#endif
+        return running_;
+    }
+
+    void Thread::join() {
+        if (!running_) return;
+#ifdef _WIN32
+        WaitForSingleObject(handle_, INFINITE);
+        CloseHandle(handle_);
+        handle_ = NULL;
+#else
+        pthread_join(handle_, NULL);
+#endif
+        running_ = false;
+    }
+
+    void Thread::sleepMs(int ms) {
+#ifdef _WIN32
+        Sleep(static_cast<DWORD>(ms));
+#else
+        usleep(static_cast<useconds_t>(ms) * 1000);
+#endif
+    }
+
+    int Thread::hardwareConcurrency() {
+#ifdef _WIN32
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwNumberOfProcessors > 0 ? static_cast<int>(info.dwNumberOfProcessors) : 1;
+#else
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        return n > 0 ? static_cast<int>(n) : 1;
+#endif
+    }
+
+} // namespace Engine
@@ -0,0 +1,50 @@
+#ifndef ENGINE_THREAD_H
+#define ENGINE_THREAD_H
+
+// Hilo mínimo sobre CreateThread (Windows) o pthreads, para C++98.
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+namespace Engine {
+
+    typedef void (*ThreadFunc)(void* arg);
+
+    class Thread {
+    public:
+        Thread();
+        ~Thread();
+
+        bool start(ThreadFunc fn, void* arg);
+        void join();
+        bool running() const { return running_; }
+
+        static void sleepMs(int ms);
+        static int  hardwareConcurrency();   // núcleos lógicos (al menos 1)
+
+    private:
+#ifdef _WIN32
+        HANDLE handle_;
+#else
+        pthread_t handle_;
+#endif
+        bool running_;
+        ThreadFunc fn_;
+        void* arg_;
+
+#ifdef _WIN32
+        static DWORD WINAPI trampoline(LPVOID self);
+#else
+        static void* trampoline(void* self);
+#endif
+
+        Thread(const Thread&);
+        Thread& operator=(const Thread&);
+    };
+
+} // namespace Engine
+
+#endif // ENGINE_THREAD_H
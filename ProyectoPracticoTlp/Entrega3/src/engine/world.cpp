@@ -0,0 +1,578 @@
+#include "engine/world.h"
+#include "engine/console_renderer.h"
+#include "engine/log.h"
+
+#include <iostream>
+#include <cstdio>
+
+namespace Engine {
+
+    World& defaultWorld() {
+        static World world;
+        return world;
+    }
+
+    // ---------------------------------------------------------------------
+    // Helpers
+    // ---------------------------------------------------------------------
+
+    // Los tipos son símbolos fijos (symbols.h): cada pregunta es un ==
+    static bool isSnakeHeadType(Symbol t) { return t == TYPE_SNAKE; }
+    static bool isSnakeBodyType(Symbol t) { return t == TYPE_SNAKE_BODY; }
+    static bool isFoodType(Symbol t)      { return t == TYPE_FOOD; }
+
+    // Carácter de cada tipo de entidad, indexado por su símbolo
+    static const char kTypeChars[TYPE_FOOD + 1] = {
+        '?',                                    // sin tipo
+        '#', 'O', 'T', 'L', 'J', 'S', 'Z',      // I, O, T, L, J, S, Z
+        '?', '#',                               // Tetris, Block
+        'S', 's', 'F'                           // Snake, SnakeBody, Food
+    };
+
+    static char symbolFor(Symbol t) {
+        return (t >= 0 && t <= TYPE_FOOD) ? kTypeChars[t] : '?';
+    }
+
+    // ---------------------------------------------------------------------
+    // Rejilla de ocupación
+    // ---------------------------------------------------------------------
+
+    // Tipo de celda que deja cada entidad; la pieza activa de Tetris no se
+    // registra porque nadie consulta colisiones contra ella.
+    static int cellKindFor(Symbol t) {
+        if (isSnakeHeadType(t)) return CELL_SNAKE_HEAD;
+        if (isSnakeBodyType(t)) return CELL_SNAKE_BODY;
+        if (isFoodType(t))      return CELL_FOOD;
+        return CELL_EMPTY;
+    }
+
+    void World::gridPlace(int e) {
+        int kind = cellKindFor(entities_.type(e));
+        if (kind != CELL_EMPTY) grid_.set(entities_.gx(e), entities_.gy(e), entities_.id(e), kind);
+    }
+
+    void World::gridRemove(int e) {
+        grid_.clearIf(entities_.gx(e), entities_.gy(e), entities_.id(e));
+    }
+
+    void World::gridMove(int e, int x, int y) {
+        gridRemove(e);
+        entities_.gx(e) = x;
+        entities_.gy(e) = y;
+        gridPlace(e);
+    }
+
+#ifdef ENGINE_CHECK_GRID
+    // Validación diferencial: cada consulta a la rejilla se compara con el
+    // recorrido lineal (por la vista de la clase) que hacía el motor antes
+    // de tenerla.
+    void World::checkGridAnswer(const char* what, int x, int y, bool grid, bool scan) {
+        ++gridChecks_;
+        if (grid == scan) return;
+        ++gridMismatches_;
+        std::cerr << "[Engine] grid mismatch " << what << " at (" << x << "," << y
+                  << "): grid=" << grid << " scan=" << scan << "\n";
+    }
+
+    static bool viewHas(const EntityStore& s, int kind, int x, int y, int ignoreId) {
+        const std::vector<int> &v = s.view(kind);
+        for (size_t i = 0; i < v.size(); ++i) {
+            int e = v[i];
+            if (s.id(e) != ignoreId && s.gx(e) == x && s.gy(e) == y) return true;
+        }
+        return false;
+    }
+#endif
+
+    int World::foodAt(int x, int y) {
+        int food = -1;
+        if (grid_.kindAt(x, y) == CELL_FOOD) food = findEntity(grid_.idAt(x, y));
+#ifdef ENGINE_CHECK_GRID
+        checkGridAnswer("foodAt", x, y, food >= 0, viewHas(entities_, KIND_FOOD, x, y, 0));
+#endif
+        return food;
+    }
+
+    // ¿Hay un segmento de la serpiente en (x,y)? ignoreId permite excluir
+    // la cola, que se libera en el mismo paso si la serpiente no come.
+    bool World::snakeAt(int x, int y, int ignoreId) {
+        int kind = grid_.kindAt(x, y);
+        bool hit = (kind == CELL_SNAKE_HEAD || kind == CELL_SNAKE_BODY) &&
+                   grid_.idAt(x, y) != ignoreId;
+#ifdef ENGINE_CHECK_GRID
+        checkGridAnswer("snakeAt", x, y, hit, viewHas(entities_, KIND_SNAKE, x, y, ignoreId));
+#endif
+        return hit;
+    }
+
+    // Una celda vacía al azar, uniforme y en tiempo constante, de la lista
+    // de celdas libres de la rejilla. Si no queda ninguna la serpiente llenó
+    // el tablero y la partida termina.
+    void World::placeFoodRandom(int food) {
+        gridRemove(food);
+        int n = grid_.freeCount();
+        if (n == 0) {
+            endGame("tablero lleno");
+            return;
+        }
+        int x, y;
+        grid_.freeCell(randomBelow(n), x, y);
+#ifdef ENGINE_CHECK_GRID
+        int self = entities_.id(food);
+        bool scan = viewHas(entities_, KIND_SNAKE, x, y, self) || viewHas(entities_, KIND_FOOD, x, y, self);
+        checkGridAnswer("freeCell", x, y, false, scan);
+#endif
+        gridMove(food, x, y);
+    }
+
+    void World::ensureFoodExists() {
+        if (hasFood()) return;
+        int f = entities_.create(TYPE_FOOD);
+        placeFoodRandom(f);
+        LOG_DEBUG(ENGINE, "ensureFoodExists -> Food id=" << entities_.id(f)
+                          << " at (" << entities_.gx(f) << "," << entities_.gy(f) << ")");
+    }
+
+    // Saca la siguiente pieza en la parte superior reutilizando la entidad
+    // activa; si ya no cabe, la partida termina.
+    int World::spawnRandomTetrisPiece() {
+        int shape = randomBelow(SHAPE_COUNT);
+
+        int e = (tetrisId_ != -1) ? findEntity(tetrisId_) : -1;
+        if (e < 0) {
+            e = entities_.create(TYPE_I + shape);
+            tetrisId_ = entities_.id(e);
+        } else {
+            entities_.setType(e, TYPE_I + shape);
+        }
+        int &gx = entities_.gx(e);
+        int &gy = entities_.gy(e);
+        gx = BOARD_WIDTH / 2 - 2;
+        gy = 0;
+        tetrisShape_ = shape;
+        tetrisRot_   = 0;
+
+        LOG_DEBUG(ENGINE, "spawnRandomTetrisPiece type=" << shapeName(shape)
+                          << " id=" << tetrisId_ << " at (" << gx << "," << gy << ")");
+
+        if (!board_.fits(tetrisShape_, tetrisRot_, gx, gy)) {
+            endGame("Tetris: no hay espacio para la siguiente pieza");
+        }
+        return tetrisId_;
+    }
+
+    void World::fixTetrisPiece(int e) {
+        if (e < 0) return;
+        int lines = board_.lock(tetrisShape_, tetrisRot_, entities_.gx(e), entities_.gy(e));
+        LOG_DEBUG(ENGINE, "Tetris piece fixed id=" << entities_.id(e)
+                          << " at (" << entities_.gx(e) << "," << entities_.gy(e) << ")");
+        if (lines > 0) {
+            LOG_INFO(ENGINE, "Tetris lines cleared: " << lines);
+            addScore(100 * lines);
+        }
+
+        spawnRandomTetrisPiece();
+    }
+
+    // ---------------------------------------------------------------------
+    // Inicialización
+    // ---------------------------------------------------------------------
+
+    World::World()
+        : grid_(BOARD_WIDTH, BOARD_HEIGHT),
+          board_(BOARD_WIDTH, BOARD_HEIGHT),
+          rng_(1)
+    {
+#ifdef ENGINE_CHECK_GRID
+        gridChecks_     = 0;   // se acumulan entre partidas del mismo mundo
+        gridMismatches_ = 0;
+#endif
+        reset();
+    }
+
+    void World::reset() {
+        entities_.clear();
+        grid_.clear();
+        snake_.clear();
+        score_     = 0;
+        gameEnded_ = false;
+        tetrisId_  = -1;
+        board_.clear();
+        tetrisShape_ = -1;
+        tetrisRot_   = 0;
+        snakeId_   = -1;
+        snakeDirX_ = 1;   // empieza moviéndose a la derecha
+        snakeDirY_ = 0;
+    }
+
+    // ---------------------------------------------------------------------
+    // Eventos
+    // ---------------------------------------------------------------------
+
+    bool World::handleKey(int key) {
+        if (gameEnded_) return false;
+
+        switch (key) {
+            case 'q':
+            case 'Q':
+            case 27: // ESC
+                gameEnded_ = true;
+                return false;
+            // Controles Tetris
+            case 'j':
+                if (tetrisId_ != -1) moveEntity(tetrisId_, -1, 0);
+                break;
+            case 'l':
+                if (tetrisId_ != -1) moveEntity(tetrisId_, 1, 0);
+                break;
+            case 'k':
+                if (tetrisId_ != -1) moveEntity(tetrisId_, 0, 1);
+                break;
+            case 'i':
+                if (tetrisId_ != -1) rotateEntity(tetrisId_);
+                break;
+            case ' ':
+                if (tetrisId_ != -1) dropEntity(tetrisId_);
+                break;
+            // Controles Snake
+            case 'w':
+            case 'W':
+                snakeDirX_ = 0; snakeDirY_ = -1; break;
+            case 's':
+            case 'S':
+                snakeDirX_ = 0; snakeDirY_ = 1; break;
+            case 'a':
+            case 'A':
+                snakeDirX_ = -1; snakeDirY_ = 0; break;
+            case 'd':
+            case 'D':
+                snakeDirX_ = 1; snakeDirY_ = 0; break;
+            default:
+                break;
+        }
+
+        return !gameEnded_;
+    }
+
+    // ---------------------------------------------------------------------
+    // Dibujo
+    // ---------------------------------------------------------------------
+
+    // Celda (x,y) del tablero dentro del frame: fila 0 = puntaje, borde '|'
+    static void drawCell(ConsoleRenderer& out, int x, int y, char c) {
+        if (x >= 0 && x < BOARD_WIDTH && y >= 0 && y < BOARD_HEIGHT) {
+            out.put(x + 1, y + 1, c);
+        }
+    }
+
+    void World::draw(ConsoleRenderer& out) const {
+        out.clear();
+
+        char line[32];
+        std::sprintf(line, "Score: %d", score_);
+        out.print(0, 0, line);
+
+        for (int y = 0; y < BOARD_HEIGHT; ++y) {
+            out.put(0, y + 1, '|');
+            out.put(BOARD_WIDTH + 1, y + 1, '|');
+            unsigned int row = board_.row(y);
+            for (int x = 0; x < BOARD_WIDTH; ++x, row >>= 1) {
+                drawCell(out, x, y, (row & 1u) ? '#' : '.');
+            }
+        }
+
+        // En orden de inserción, como antes: si dos entidades se pisan gana
+        // la última creada
+        int n = static_cast<int>(entities_.size());
+        for (int e = 0; e < n; ++e) {
+            int gx = entities_.gx(e);
+            int gy = entities_.gy(e);
+            char c = symbolFor(entities_.type(e));
+            if (isActiveTetrisPiece(e)) {
+                const PieceMask &m = pieceMask(tetrisShape_, tetrisRot_);
+                for (int r = 0; r < 4; ++r) {
+                    for (int k = 0; k < 4; ++k) {
+                        if ((m.rows[r] >> k) & 1u) drawCell(out, gx + k, gy + r, c);
+                    }
+                }
+                continue;
+            }
+            int w = entities_.w(e);
+            int h = entities_.h(e);
+            for (int dy = 0; dy < h; ++dy) {
+                for (int dx = 0; dx < w; ++dx) {
+                    drawCell(out, gx + dx, gy + dy, c);
+                }
+            }
+        }
+
+        out.print(0, BOARD_HEIGHT + 1, "Controles: q=salir, wasd=Snake, j/l/k/i/espacio=Tetris");
+    }
+
+    // ---------------------------------------------------------------------
+    // Score
+    // ---------------------------------------------------------------------
+
+    void World::setScore(int value) {
+        score_ = value;
+        LOG_INFO(ENGINE, "setScore " << score_);
+    }
+
+    void World::addScore(int delta) {
+        score_ += delta;
+        LOG_DEBUG(ENGINE, "addScore " << delta << " => " << score_);
+    }
+
+    // ---------------------------------------------------------------------
+    // Spawn de bloques / entidades (desde el script)
+    // ---------------------------------------------------------------------
+
+    int World::spawnBlock(const std::string& type, int gridX, int gridY) {
+        return spawnBlock(findSymbol(type), gridX, gridY);
+    }
+
+    int World::spawnBlock(Symbol type, int gridX, int gridY) {
+        if (isTetrisType(type)) {
+            if (tetrisId_ == -1) {
+                return spawnRandomTetrisPiece();
+            } else {
+                LOG_DEBUG(ENGINE, "spawnBlock(Tetris) called but piece already active id="
+                                  << tetrisId_);
+                return tetrisId_;
+            }
+        }
+
+        if (snakeId_ == -1) {
+            int e = entities_.create(TYPE_SNAKE);
+            entities_.gx(e) = gridX;
+            entities_.gy(e) = gridY;
+
+            snakeId_  = entities_.id(e);
+            snakeDirX_ = 1;
+            snakeDirY_ = 0;
+            snake_.reset(snakeId_);
+            gridPlace(e);
+
+            LOG_DEBUG(ENGINE, "spawnBlock -> Snake head id=" << snakeId_
+                              << " at (" << gridX << "," << gridY << ")");
+            return snakeId_;
+        }
+
+        int f = entities_.create(TYPE_FOOD);
+        placeFoodRandom(f);
+
+        LOG_DEBUG(ENGINE, "spawnBlock -> Food id=" << entities_.id(f)
+                          << " at (" << entities_.gx(f) << "," << entities_.gy(f) << ")");
+
+        return entities_.id(f);
+    }
+
+    // ---------------------------------------------------------------------
+    // Movimiento
+    // ---------------------------------------------------------------------
+
+    void World::moveEntity(int id, int dx, int dy) {
+        int e = findEntity(id);   // el índice sigue valiendo aunque se creen entidades
+        if (e < 0) return;
+
+        if (isActiveTetrisPiece(e)) {
+            int &gx = entities_.gx(e);
+            int &gy = entities_.gy(e);
+            // Se avanza de a una celda para no atravesar bloques
+            int x = gx;
+            int y = gy;
+            int stepX = dx < 0 ? -1 : 1;
+            for (int i = 0; i != dx; i += stepX) {
+                if (!board_.fits(tetrisShape_, tetrisRot_, x + stepX, y)) break;
+                x += stepX;
+            }
+            int stepY = dy < 0 ? -1 : 1;
+            for (int i = 0; i != dy; i += stepY) {
+                if (!board_.fits(tetrisShape_, tetrisRot_, x, y + stepY)) {
+                    if (stepY > 0) {
+                        gx = x;
+                        gy = y;
+                        fixTetrisPiece(e);
+                        return;
+                    }
+                    break;
+                }
+                y += stepY;
+            }
+            gx = x;
+            gy = y;
+
+            LOG_DEBUG(ENGINE, "moveEntity(Tetris) id=" << id
+                              << " dx=" << dx << " dy=" << dy
+                              << " => (" << gx << "," << gy << ")");
+            return;
+        }
+
+        if (isSnakeHeadType(entities_.type(e))) {
+            ensureFoodExists();
+
+            int newHeadX = entities_.gx(e) + snakeDirX_;
+            int newHeadY = entities_.gy(e) + snakeDirY_;
+
+            if (newHeadX < 0) newHeadX = BOARD_WIDTH - 1;
+            if (newHeadX >= BOARD_WIDTH) newHeadX = 0;
+            if (newHeadY < 0) newHeadY = BOARD_HEIGHT - 1;
+            if (newHeadY >= BOARD_HEIGHT) newHeadY = 0;
+
+            int eatenFood = foodAt(newHeadX, newHeadY);
+            bool willEat = (eatenFood >= 0);
+
+            // Si no come, la cola se mueve en este mismo paso y su celda queda libre
+            int freedTail = (!willEat && !snake_.empty()) ? snake_.tailId() : 0;
+            if (snakeAt(newHeadX, newHeadY, freedTail)) {
+                endGame("Snake: self collision");
+                return;
+            }
+
+            if (!snake_.empty()) {
+                int grown = -1;
+                if (willEat) {
+                    // El segmento nuevo ocupa la celda que deja la cabeza
+                    grown = entities_.create(TYPE_SNAKE_BODY);
+                }
+
+                snake_.step(entities_, grid_, newHeadX, newHeadY, grown >= 0 ? entities_.id(grown) : 0);
+
+                if (grown >= 0) {
+                    LOG_DEBUG(ENGINE, "Snake grew -> new segment id="
+                                      << entities_.id(grown) << " at ("
+                                      << entities_.gx(grown) << ","
+                                      << entities_.gy(grown) << ")");
+                }
+            }
+
+            // La comida se recoloca con la serpiente ya movida, así nunca
+            // aparece bajo la cabeza nueva.
+            if (willEat) {
+                addScore(10);
+                placeFoodRandom(eatenFood);
+                LOG_DEBUG(ENGINE, "Snake ate food -> new food at ("
+                                  << entities_.gx(eatenFood) << "," << entities_.gy(eatenFood) << ")");
+            }
+
+            LOG_DEBUG(ENGINE, "moveEntity(Snake) id=" << id
+                              << " => (" << entities_.gx(e) << "," << entities_.gy(e) << ")");
+            return;
+        }
+
+        int newGx = entities_.gx(e) + dx;
+        int newGy = entities_.gy(e) + dy;
+
+        if (newGx < 0) newGx = 0;
+        if (newGx > BOARD_WIDTH - entities_.w(e)) newGx = BOARD_WIDTH - entities_.w(e);
+        if (newGy < 0) newGy = 0;
+        if (newGy > BOARD_HEIGHT - entities_.h(e)) newGy = BOARD_HEIGHT - entities_.h(e);
+
+        gridMove(e, newGx, newGy);
+
+        LOG_DEBUG(ENGINE, "moveEntity id=" << id
+                          << " dx=" << dx << " dy=" << dy
+                          << " => (" << entities_.gx(e) << "," << entities_.gy(e) << ")");
+    }
+
+    // ---------------------------------------------------------------------
+    // Estado del juego
+    // ---------------------------------------------------------------------
+
+    // FNV-1a de 64 bits sobre todo el estado que afecta a la simulación
+    static void hashInt(unsigned long long &h, long long v) {
+        for (int i = 0; i < 8; ++i) {
+            h ^= static_cast<unsigned long long>(v >> (i * 8)) & 0xFFull;
+            h *= 1099511628211ull;
+        }
+    }
+
+    static void hashString(unsigned long long &h, const char *s) {
+        size_t n = 0;
+        for (; s[n]; ++n) {
+            h ^= static_cast<unsigned char>(s[n]);
+            h *= 1099511628211ull;
+        }
+        hashInt(h, static_cast<long long>(n));
+    }
+
+    unsigned long long World::stateHash() const {
+        unsigned long long h = 14695981039346656037ull;
+        hashInt(h, score_);
+        hashInt(h, gameEnded_ ? 1 : 0);
+        hashInt(h, snakeDirX_);
+        hashInt(h, snakeDirY_);
+        hashInt(h, tetrisShape_);
+        hashInt(h, tetrisRot_);
+        hashInt(h, static_cast<long long>(rng_.state()));   // una repetición desviada se nota aunque el tablero coincida
+        int n = static_cast<int>(entities_.size());
+        for (int e = 0; e < n; ++e) {
+            hashInt(h, entities_.id(e));
+            hashInt(h, entities_.gx(e));
+            hashInt(h, entities_.gy(e));
+            hashString(h, symbolName(entities_.type(e)));   // el nombre: la huella no depende de la numeración
+        }
+        for (size_t i = 0; i < snake_.length(); ++i) hashInt(h, snake_[i]);
+        for (int y = 0; y < BOARD_HEIGHT; ++y) hashInt(h, board_.row(y));
+        return h;
+    }
+
+    // ---------------------------------------------------------------------
+    // STUBS y utilidades
+    // ---------------------------------------------------------------------
+
+    void World::rotateEntity(int id) {
+        int e = findEntity(id);
+        if (!isActiveTetrisPiece(e)) {
+            LOG_DEBUG(ENGINE, "rotateEntity id=" << id << " (stub)");
+            return;
+        }
+
+        // Giro horario con desplazamientos laterales si choca con la pared
+        static const int kicks[] = { 0, -1, 1, -2, 2 };
+        int &gx = entities_.gx(e);
+        int gy  = entities_.gy(e);
+        int rot = (tetrisRot_ + 1) & 3;
+        for (int k = 0; k < 5; ++k) {
+            if (board_.fits(tetrisShape_, rot, gx + kicks[k], gy)) {
+                gx += kicks[k];
+                tetrisRot_ = rot;
+                LOG_DEBUG(ENGINE, "rotateEntity id=" << id << " rot=" << rot
+                                  << " at (" << gx << "," << gy << ")");
+                return;
+            }
+        }
+    }
+
+    void World::dropEntity(int id) {
+        int e = findEntity(id);
+        if (e < 0) return;
+
+        if (isActiveTetrisPiece(e)) {
+            int &gy = entities_.gy(e);
+            gy = board_.dropY(tetrisShape_, tetrisRot_, entities_.gx(e), gy);
+            LOG_DEBUG(ENGINE, "dropEntity id=" << id << " -> bottom");
+            fixTetrisPiece(e);
+            return;
+        }
+
+        int y = entities_.gy(e);
+        while (y < BOARD_HEIGHT - entities_.h(e)) {
+            y += 1;
+        }
+        gridMove(e, entities_.gx(e), y);
+        LOG_DEBUG(ENGINE, "dropEntity id=" << id
+                          << " -> bottom");
+    }
+
+    void World::endGame(const std::string& r) {
+        gameEnded_ = true;
+        LOG_INFO(ENGINE, "endGame() called. Reason: " << r);
+    }
+
+    void World::drawText(const std::string& t, int x, int y) {
+        LOG_INFO(ENGINE, "drawText \"" << t << "\" at ("
+                         << x << "," << y << ") (console stub)");
+    }
+
+} // namespace Engine
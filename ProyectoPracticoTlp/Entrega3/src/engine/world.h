@@ -0,0 +1,113 @@
+#ifndef ENGINE_WORLD_H
+#define ENGINE_WORLD_H
+
+#include "engine/api.h"
+#include "engine/entity_store.h"
+#include "engine/occupancy_grid.h"
+#include "engine/random.h"
+#include "engine/snake_body.h"
+#include "engine/tetris_board.h"
+
+#include <string>
+
+namespace Engine {
+
+    class ConsoleRenderer;
+
+    // Estado completo de una partida. Cada mundo es independiente (incluido
+    // su generador aleatorio), así que se pueden simular muchos a la vez en
+    // hilos distintos mientras cada uno se use desde un solo hilo.
+    //
+    // Las funciones libres de api.h operan sobre defaultWorld().
+    class World {
+    public:
+        World();
+
+        void reset();                       // equivale a initEngine() sin E/S
+        void seed(unsigned int s) { rng_.seed(s); }
+
+        bool handleKey(int key);
+        void draw(ConsoleRenderer& out) const;
+
+        int  spawnBlock(const std::string& type, int gridX, int gridY);
+        int  spawnBlock(Symbol type, int gridX, int gridY);   // TYPE_* ya resuelto
+        void moveEntity(int id, int dx, int dy);
+        void rotateEntity(int id);
+        void dropEntity(int id);
+
+        void setScore(int value);
+        void addScore(int delta);
+        int  score() const { return score_; }
+
+        void endGame(const std::string& r);
+        void drawText(const std::string& t, int x, int y);
+        bool isGameEnded() const { return gameEnded_; }
+
+        unsigned long long stateHash() const;
+
+#ifdef ENGINE_CHECK_GRID
+        long gridChecks() const     { return gridChecks_; }
+        long gridMismatches() const { return gridMismatches_; }
+#endif
+
+    private:
+        EntityStore   entities_;
+        OccupancyGrid grid_;
+        int  score_;
+        bool gameEnded_;
+
+        // IDs especiales
+        int tetrisId_;   // id de la pieza de Tetris actual
+        int snakeId_;    // id de la cabeza de la serpiente
+
+        // Tablero de Tetris (bloques fijos) y forma/rotación de la pieza activa.
+        // La pieza activa es una sola entidad que se reutiliza al fijarse.
+        TetrisBoard board_;
+        int tetrisShape_;
+        int tetrisRot_;
+
+        // Segmentos de la serpiente: ids en orden cabeza -> cola
+        SnakeBody snake_;
+
+        // Dirección actual de la serpiente (en la grilla)
+        int snakeDirX_;
+        int snakeDirY_;
+
+        Pcg32 rng_;   // propio: std::rand() es global y no es de fiar entre hilos
+
+#ifdef ENGINE_CHECK_GRID
+        long gridChecks_;
+        long gridMismatches_;
+        void checkGridAnswer(const char* what, int x, int y, bool grid, bool scan);
+#endif
+
+        int randomBelow(int n) { return static_cast<int>(rng_.below(static_cast<unsigned int>(n))); }
+        // Índice denso de una entidad (-1 si no existe). Ninguno se invalida
+        // al crear, y el mundo no borra entidades.
+        int findEntity(int id) const { return entities_.indexOf(id); }
+
+        void gridPlace(int e);
+        void gridRemove(int e);
+        void gridMove(int e, int x, int y);
+        int  foodAt(int x, int y);
+        bool snakeAt(int x, int y, int ignoreId);
+
+        bool hasFood() const { return entities_.count(KIND_FOOD) > 0; }
+        void placeFoodRandom(int food);
+        void ensureFoodExists();
+        int  spawnRandomTetrisPiece();
+        void fixTetrisPiece(int e);
+        bool isActiveTetrisPiece(int e) const {
+            return e >= 0 && entities_.id(e) == tetrisId_ && tetrisShape_ >= 0;
+        }
+
+        World(const World&);
+        World& operator=(const World&);
+    };
+
+    // Mundo que usan las funciones libres de api.h (y el intérprete por defecto)
+    World& defaultWorld();
+
+} // namespace Engine
+
+#endif // ENGINE_WORLD_H
@@ -1,29 +1,324 @@
 #include "interpreter/script_interpreter.h"
 #include "engine/api.h"
+#include "engine/world.h"
+#include "engine/batch_runner.h"
+#include "engine/log.h"
+#include "engine/frame_scheduler.h"
+#include "engine/input_log.h"
 
 #include <iostream>
+#include <fstream>
 #include <cstdlib>
+#include <ctime>
 #include <string>
+#include <vector>
+#include <utility>
 
 #ifdef _WIN32
 #include <windows.h>
 #else
-#include <unistd.h>
+#include <sys/time.h>
 #endif
 
-static void sleepMs(int ms) {
+static double nowSeconds() {
 #ifdef _WIN32
-    Sleep(static_cast<DWORD>(ms));
+    LARGE_INTEGER freq, t;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&t);
+    return static_cast<double>(t.QuadPart) / static_cast<double>(freq.QuadPart);
 #else
-    usleep(static_cast<useconds_t>(ms) * 1000);
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return static_cast<double>(tv.tv_sec) + static_cast<double>(tv.tv_usec) * 1e-6;
 #endif
 }
 
+// ---------------------------------------------------------------------
+// Modo headless: sin dibujo, sin terminal y sin esperas entre frames
+// ---------------------------------------------------------------------
+
+// Opciones de la línea de comandos; la semilla y --record sirven también
+// para el modo interactivo
+struct HeadlessOptions {
+    bool         enabled;
+    unsigned int seed;
+    bool         hasSeed;
+    std::string  keysFile;      // líneas "frame tecla"
+    std::string  recordFile;    // graba las teclas de la partida (.keys)
+    std::string  replayFile;    // repite una grabación y compara la huella
+    int          randomEvery;   // >0: tecla al azar cada ~N frames
+    int          batch;         // >0: N partidas independientes en paralelo
+    int          threads;       // hilos del lote (0 = uno por núcleo)
+
+    HeadlessOptions()
+        : enabled(false), seed(0), hasSeed(false), randomEvery(0), batch(0), threads(0) {}
+};
+
+// Fuente de teclas del modo headless: eventos de un archivo, ordenados por
+// frame, más teclas aleatorias con su propio generador (no toca el del motor).
+class ScriptedInput {
+public:
+    ScriptedInput(unsigned int seed, int randomEvery)
+        : next_(0), lcg_(seed ^ 0x9E3779B9u), randomEvery_(randomEvery) {}
+
+    // Vuelve al primer evento con otra semilla (para reutilizar un archivo ya leído)
+    void restart(unsigned int seed) {
+        next_ = 0;
+        lcg_  = seed ^ 0x9E3779B9u;
+    }
+
+    // Teclas de una grabación en vez de un archivo de texto
+    void setEvents(const std::vector< std::pair<int,int> >& events) {
+        events_ = events;
+        next_   = 0;
+    }
+
+    bool load(const std::string& path) {
+        std::ifstream in(path.c_str());
+        if (!in.is_open()) return false;
+        int frame;
+        std::string key;
+        while (in >> frame >> key) {
+            int code = key[0];
+            if (key == "space") code = ' ';
+            else if (key == "esc") code = 27;
+            events_.push_back(std::make_pair(frame, code));
+        }
+        return true;
+    }
+
+    // Entrega las teclas del frame (y las anota en rec, si hay); devuelve
+    // false si alguna terminó el juego
+    bool deliver(Engine::World& world, int frame, Engine::InputLog* rec) {
+        if (rec) rec->beginFrame(frame);
+        while (next_ < events_.size() && events_[next_].first <= frame) {
+            int key = events_[next_++].second;
+            if (rec) rec->add(key);
+            if (!world.handleKey(key)) return false;
+        }
+        if (randomEvery_ > 0 && nextRand() % randomEvery_ == 0) {
+            static const char keys[] = "wasdjlki ";
+            int key = keys[nextRand() % (sizeof(keys) - 1)];
+            if (rec) rec->add(key);
+            if (!world.handleKey(key)) return false;
+        }
+        return true;
+    }
+
+private:
+    std::vector< std::pair<int,int> > events_;
+    size_t next_;
+    unsigned int lcg_;
+    int randomEvery_;
+
+    unsigned int nextRand() {
+        lcg_ = lcg_ * 1664525u + 1013904223u;
+        return lcg_ >> 8;
+    }
+};
+
+// Corre una partida completa sobre 'world'; devuelve los frames simulados
+static int simulate(Engine::World& world, ScriptInterpreter& interp,
+                    ScriptedInput& input, int frames, Engine::InputLog* rec)
+{
+    // Los nombres se resuelven una vez; cada frame llama por símbolo
+    const Engine::Symbol update = Engine::intern("update");
+    interp.callMethod(Engine::intern("init"));
+
+    int f = 0;
+    while (f < frames && !world.isGameEnded()) {
+        if (!input.deliver(world, f, rec)) break;
+        interp.callMethod(update);
+        ++f;
+    }
+
+    if (!world.isGameEnded()) {
+        interp.callMethod(Engine::intern("end"));
+    }
+    return f;
+}
+
+// Guarda la grabación con el resultado de la partida
+static bool saveRecording(Engine::InputLog& log, const std::string& path,
+                          int frames, unsigned long long hash)
+{
+    log.frames = frames;
+    log.hash   = hash;
+    if (!log.save(path)) {
+        std::cerr << "No se pudo escribir la grabacion: " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Con --replay la semilla, las teclas, los frames y (si no se indica otro)
+// el script salen de la grabación, y al final se compara la huella
+static int runHeadless(const std::string& script_arg,
+                       int frames,
+                       const HeadlessOptions& opts)
+{
+    std::string script_path = script_arg;
+    unsigned int seed = opts.hasSeed ? opts.seed : static_cast<unsigned int>(std::time(NULL));
+    Engine::InputLog replay;
+    const bool replaying = !opts.replayFile.empty();
+    if (replaying) {
+        if (!replay.load(opts.replayFile)) {
+            std::cerr << "No se pudo leer la grabacion: " << opts.replayFile << "\n";
+            return 1;
+        }
+        if (script_path.empty()) script_path = replay.script;
+        seed   = replay.seed;
+        frames = replay.frames;
+    }
+
+    ScriptedInput input(seed, replaying ? 0 : opts.randomEvery);
+    if (replaying) {
+        input.setEvents(replay.events);
+    } else if (!opts.keysFile.empty() && !input.load(opts.keysFile)) {
+        std::cerr << "No se pudo abrir el archivo de teclas: " << opts.keysFile << "\n";
+        return 1;
+    }
+
+    // Solo avisos y errores del motor mientras dura la simulación
+    Engine::Log::setLevel(LOG_LEVEL_WARN);
+
+    Engine::initEngine();
+    Engine::seedRandom(seed);
+
+    ScriptInterpreter interp;
+    if (!interp.loadASTFile(script_path)) {
+        std::cerr << "Fallo cargando script: " << script_path << "\n";
+        Engine::shutdownEngine();
+        return 1;
+    }
+
+    Engine::InputLog record;
+    record.seed   = seed;
+    record.script = script_path;
+    Engine::InputLog* rec = opts.recordFile.empty() ? NULL : &record;
+
+    double t0 = nowSeconds();
+    int f = simulate(Engine::defaultWorld(), interp, input, frames, rec);
+    double secs = nowSeconds() - t0;
+
+    unsigned long long hash = Engine::stateHash();
+    Engine::shutdownEngine();
+
+    std::cout << "[Headless] script=" << script_path
+              << " semilla=" << seed
+              << " frames=" << f
+              << " segundos=" << secs
+              << " frames/s=" << (secs > 0 ? f / secs : 0.0)
+              << " hash=0x" << std::hex << hash << std::dec << "\n";
+
+    if (rec && !saveRecording(record, opts.recordFile, f, hash)) return 1;
+    if (replaying) {
+        bool same = (hash == replay.hash && f == replay.frames);
+        std::cout << "[Replay] " << opts.replayFile << ": " << replay.events.size() << " teclas, "
+                  << (same ? "misma huella" : "DISTINTA") << " (grabada 0x" << std::hex << replay.hash
+                  << std::dec << ", " << replay.frames << " frames)\n";
+        return same ? 0 : 2;
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------
+// Lote headless: N partidas independientes, cada una en su propio mundo
+// ---------------------------------------------------------------------
+
+struct BatchGames {
+    const ScriptInterpreter* script;   // ya cargado; cada partida usa una copia
+    const ScriptedInput*     input;
+    unsigned int             seed;     // la partida i usa seed + i
+    int                      frames;
+    std::vector<unsigned long long> hashes;
+    std::vector<int>                framesRun;
+};
+
+static void runBatchGame(int index, void* ctx) {
+    BatchGames* b = static_cast<BatchGames*>(ctx);
+    unsigned int seed = b->seed + static_cast<unsigned int>(index);
+
+    Engine::World world;
+    world.seed(seed);
+    ScriptInterpreter interp(*b->script);
+    interp.bindWorld(world);
+    ScriptedInput input(*b->input);
+    input.restart(seed);
+
+    b->framesRun[index] = simulate(world, interp, input, b->frames, NULL);
+    b->hashes[index]    = world.stateHash();
+}
+
+static int runBatch(const std::string& script_path,
+                    int frames,
+                    const HeadlessOptions& opts)
+{
+    unsigned int seed = opts.hasSeed ? opts.seed : static_cast<unsigned int>(std::time(NULL));
+    ScriptedInput input(seed, opts.randomEvery);
+    if (!opts.keysFile.empty() && !input.load(opts.keysFile)) {
+        std::cerr << "No se pudo abrir el archivo de teclas: " << opts.keysFile << "\n";
+        return 1;
+    }
+
+    Engine::Log::setLevel(LOG_LEVEL_WARN);
+    Engine::Log::start();
+
+    ScriptInterpreter script;
+    if (!script.loadASTFile(script_path)) {
+        std::cerr << "Fallo cargando script: " << script_path << "\n";
+        Engine::Log::stop();
+        return 1;
+    }
+    script.compileAll();   // una vez, no en cada copia
+
+    BatchGames b;
+    b.script = &script;
+    b.input  = &input;
+    b.seed   = seed;
+    b.frames = frames;
+    b.hashes.assign(opts.batch, 0);
+    b.framesRun.assign(opts.batch, 0);
+
+    Engine::BatchRunner runner(opts.threads);
+    double t0 = nowSeconds();
+    runner.run(opts.batch, &runBatchGame, &b);
+    double secs = nowSeconds() - t0;
+    Engine::Log::stop();
+
+    // Huella del lote en orden de partida: no depende de cuántos hilos hubo
+    unsigned long long hash = 14695981039346656037ull;
+    long long totalFrames = 0;
+    for (int i = 0; i < opts.batch; ++i) {
+        hash = (hash ^ b.hashes[i]) * 1099511628211ull;
+        totalFrames += b.framesRun[i];
+    }
+
+    std::cout << "[Batch] script=" << script_path
+              << " semilla=" << seed
+              << " partidas=" << opts.batch
+              << " hilos=" << runner.threads()
+              << " frames=" << totalFrames
+              << " segundos=" << secs
+              << " partidas/s=" << (secs > 0 ? opts.batch / secs : 0.0)
+              << " frames/s=" << (secs > 0 ? totalFrames / secs : 0.0)
+              << " hash=0x" << std::hex << hash << std::dec << "\n";
+    return 0;
+}
+
+// Un paso de simulación cada ms_per_frame con deadlines absolutos
+// (frame_scheduler.h): el trabajo del frame ya no alarga el periodo. Si un
+// frame se atrasa se corren hasta MAX_CATCH_UP pasos seguidos. 'frames'
+// cuenta pasos de simulación.
 static int runGame(const std::string& script_path,
                    int frames,
-                   int ms_per_frame)
+                   int ms_per_frame,
+                   long long spinNs,
+                   const HeadlessOptions& opts)
 {
     Engine::initEngine();
+    unsigned int seed = opts.hasSeed ? opts.seed : static_cast<unsigned int>(std::time(NULL));
+    Engine::seedRandom(seed);
 
     ScriptInterpreter interp;
     if (!interp.loadASTFile(script_path)) {
@@ -32,37 +327,117 @@ static int runGame(const std::string& script_path,
         return 1;
     }
 
-    const std::string className = "Game";
+    // Cada tecla queda con el frame antes del cual se aplicó, como las
+    // entrega ScriptedInput al repetirla
+    Engine::InputLog record;
+    record.seed   = seed;
+    record.script = script_path;
+    if (!opts.recordFile.empty()) Engine::recordInput(&record);
 
-    interp.callMethod(className, "init");
+    const Engine::Symbol update = Engine::intern("update");
+    interp.callMethod(Engine::intern("init"));
 
+    Engine::FrameScheduler sched(static_cast<long long>(ms_per_frame) * 1000000LL, spinNs);
     int f = 0;
-    while (f < frames && Engine::pollEvents() && !Engine::isGameEnded()) {
-        interp.callMethod(className, "update");
+    while (f < frames && !Engine::isGameEnded()) {
+        record.beginFrame(f);
+        if (!Engine::pollEvents()) break;
+        for (int n = sched.advance(); n > 0 && f < frames && !Engine::isGameEnded(); --n) {
+            interp.callMethod(update);
+            ++f;
+        }
         Engine::presentFrame();
-        sleepMs(ms_per_frame);
-        ++f;
+        sched.waitForDeadline();
     }
 
     if (!Engine::isGameEnded()) {
-        interp.callMethod(className, "end");
+        interp.callMethod(Engine::intern("end"));
     }
 
+    Engine::recordInput(NULL);
+    if (!opts.recordFile.empty() && saveRecording(record, opts.recordFile, f, Engine::stateHash())) {
+        LOG_INFO(ENGINE, "grabacion: " << opts.recordFile << " (" << record.events.size()
+                         << " teclas, semilla " << seed << ", " << f << " frames)");
+    }
+    LOG_INFO(ENGINE, sched.stats().summary());
+    LOG_INFO(ENGINE, sched.stats().lateSummary());
+    LOG_INFO(ENGINE, "retraso al despertar (us): " << sched.stats().histogramText());
     Engine::shutdownEngine();
     return 0;
 }
 
+static void printUsage() {
+    std::cout << "Uso: motor_integration [script] [frames] [ms_por_frame] [opciones]\n"
+              << "  --headless          simula sin dibujar ni esperar entre frames\n"
+              << "  --seed N            semilla del motor (sin ella, la hora)\n"
+              << "  --keys ARCHIVO      teclas por frame, lineas \"frame tecla\" (modo headless)\n"
+              << "  --random-keys N     tecla al azar cada ~N frames (modo headless)\n"
+              << "  --batch N           N partidas headless en paralelo (semillas seed..seed+N-1)\n"
+              << "  --threads N         hilos para --batch (por defecto, uno por nucleo)\n"
+              << "  --record ARCHIVO    graba semilla, teclas y huella final de la partida (.keys)\n"
+              << "  --replay ARCHIVO    repite una grabacion en modo headless y compara la huella\n"
+              << "  --spin-us N         microsegundos finales de cada espera que se hacen girando\n"
+              << "                      (por defecto 200; 0 = solo dormir)\n";
+}
+
 int main(int argc, char** argv)
 {
-    if (argc >= 2) {
-        std::string script_path = argv[1];
+    std::vector<std::string> positional;
+    HeadlessOptions headless;
+    long long spinNs = Engine::FrameScheduler::DEFAULT_SPIN_NS;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--headless") {
+            headless.enabled = true;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            headless.seed    = static_cast<unsigned int>(std::strtoul(argv[++i], NULL, 10));
+            headless.hasSeed = true;
+        } else if (arg == "--keys" && i + 1 < argc) {
+            headless.keysFile = argv[++i];
+        } else if (arg == "--random-keys" && i + 1 < argc) {
+            headless.randomEvery = std::atoi(argv[++i]);
+        } else if (arg == "--batch" && i + 1 < argc) {
+            headless.batch   = std::atoi(argv[++i]);
+            headless.enabled = true;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            headless.threads = std::atoi(argv[++i]);
+        } else if (arg == "--record" && i + 1 < argc) {
+            headless.recordFile = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            headless.replayFile = argv[++i];
+            headless.enabled    = true;
+        } else if (arg == "--spin-us" && i + 1 < argc) {
+            spinNs = static_cast<long long>(std::atoi(argv[++i])) * 1000;
+        } else if (arg == "--help" || arg == "-h") {
+            printUsage();
+            return 0;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+
+    // El script de la grabación, salvo que se indique otro
+    if (!headless.replayFile.empty()) {
+        return runHeadless(positional.empty() ? std::string() : positional[0], 0, headless);
+    }
+
+    if (!positional.empty()) {
+        std::string script_path = positional[0];
         int frames = 1000000;
         int ms_per_frame = 120;
 
-        if (argc >= 3) frames       = std::atoi(argv[2]);
-        if (argc >= 4) ms_per_frame = std::atoi(argv[3]);
+        if (positional.size() >= 2) frames       = std::atoi(positional[1].c_str());
+        if (positional.size() >= 3) ms_per_frame = std::atoi(positional[2].c_str());
 
-        return runGame(script_path, frames, ms_per_frame);
+        if (headless.batch > 0) return runBatch(script_path, frames, headless);
+        if (headless.enabled) return runHeadless(script_path, frames, headless);
+        return runGame(script_path, frames, ms_per_frame, spinNs, headless);
+    }
+
+    if (headless.enabled) {
+        printUsage();
+        return 1;
     }
 
     std::cout << "=====================================\n";
@@ -96,5 +471,5 @@ int main(int argc, char** argv)
             break;
     }
 
-    return runGame(script_path, 1000000, 120);
+    return runGame(script_path, 1000000, 120, spinNs, headless);
 }
@@ -0,0 +1,159 @@
+#ifndef AST_BINARY_H
+#define AST_BINARY_H
+
+// Formato binario del AST (.astb), compartido por el analizador de Entrega1,
+// que lo escribe, y el ScriptInterpreter, que lo usa mapeado en memoria sin
+// interpretar texto. Todo es uint32 en el orden de bytes de la máquina
+// (little-endian en x86/ARM):
+//
+//   Header | Node[nodeCount] | offsets[stringCount + 1] | caracteres
+//
+// - Los nodos van por niveles: los hijos de un nodo son contiguos y están
+//   en [firstChild, firstChild + childCount), siempre después del padre.
+//   El nodo 0 es la raíz.
+// - Tipos, claves y valores de propiedades son índices de la tabla de
+//   cadenas. La cadena i ocupa [offsets[i], offsets[i+1] - 1) dentro de los
+//   caracteres y termina en '\0', así se puede usar como const char*.
+//
+// Este archivo compila como C++98 (Entrega3) y como C++17 (Entrega1).
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace AstBin {
+
+    const uint32_t VERSION   = 1;
+    const uint32_t NONE      = 0xFFFFFFFFu;   // findString: cadena ausente
+    const int      MAX_PROPS = 2;             // como AST::MAX_PROPS en Entrega1
+
+    struct Header {
+        char     magic[4];        // "BRKA"
+        uint32_t version;
+        uint32_t nodeCount;
+        uint32_t stringCount;
+        uint32_t nodesOffset;     // desde el comienzo del archivo
+        uint32_t offsetsOffset;
+        uint32_t charsOffset;
+        uint32_t fileSize;
+    };
+
+    struct Node {
+        uint32_t type;
+        uint32_t firstChild;
+        uint32_t childCount;
+        uint32_t nprops;
+        uint32_t key[MAX_PROPS];
+        uint32_t value[MAX_PROPS];
+        int32_t  line;
+        int32_t  col;
+    };
+
+    inline void setMagic(Header &h) { h.magic[0] = 'B'; h.magic[1] = 'R'; h.magic[2] = 'K'; h.magic[3] = 'A'; }
+
+    // Vista de solo lectura sobre un archivo .astb ya cargado o mapeado.
+    // open() solo revisa la cabecera, para no recorrer el archivo entero al
+    // arrancar; quien lee un nodo lo valida antes con validNode().
+    class View {
+    public:
+        View() : nodes_(NULL), offsets_(NULL), chars_(NULL), nodeCount_(0), stringCount_(0), charsSize_(0) {}
+
+        bool open(const void *data, size_t size, std::string &why) {
+            const char *base = static_cast<const char*>(data);
+            if (size < sizeof(Header)) { why = "archivo demasiado corto"; return false; }
+            Header h;
+            std::memcpy(&h, base, sizeof(h));
+            if (std::memcmp(h.magic, "BRKA", 4) != 0) { why = "no es un AST binario"; return false; }
+            if (h.version != VERSION) { why = "version de formato no soportada"; return false; }
+            // Tamaños en 64 bits: stringCount + 1 no debe dar la vuelta en 32.
+            // La tabla de offsets va antes de los caracteres y no se pisan.
+            uint64_t offsetsEnd = static_cast<uint64_t>(h.offsetsOffset) +
+                                  4 * (static_cast<uint64_t>(h.stringCount) + 1);
+            if (h.fileSize != size || h.nodeCount == 0 ||
+                h.nodesOffset % 4 != 0 || h.offsetsOffset % 4 != 0 ||
+                h.nodesOffset > size || (size - h.nodesOffset) / sizeof(Node) < h.nodeCount ||
+                h.offsetsOffset > size || offsetsEnd > h.charsOffset ||
+                h.charsOffset > size) {
+                why = "cabecera inconsistente"; return false;
+            }
+            nodes_       = reinterpret_cast<const Node*>(base + h.nodesOffset);
+            offsets_     = reinterpret_cast<const uint32_t*>(base + h.offsetsOffset);
+            chars_       = base + h.charsOffset;
+            nodeCount_   = h.nodeCount;
+            stringCount_ = h.stringCount;
+            charsSize_   = static_cast<uint32_t>(size - h.charsOffset);
+            return true;
+        }
+
+        // La cadena existe, está dentro del archivo y termina en '\0'
+        bool validString(uint32_t id) const {
+            return id < stringCount_ && offsets_[id] < offsets_[id + 1] &&
+                   offsets_[id + 1] <= charsSize_ && chars_[offsets_[id + 1] - 1] == '\0';
+        }
+
+        // El nodo i y sus cadenas son válidos, y sus hijos existen y están
+        // después de él (así un recorrido nunca entra en un ciclo)
+        bool validNode(uint32_t i) const {
+            if (i >= nodeCount_) return false;
+            const Node &n = nodes_[i];
+            if (!validString(n.type) || n.nprops > static_cast<uint32_t>(MAX_PROPS)) return false;
+            for (uint32_t p = 0; p < n.nprops; ++p)
+                if (!validString(n.key[p]) || !validString(n.value[p])) return false;
+            return n.childCount == 0 ||
+                   (n.firstChild > i && n.firstChild <= nodeCount_ &&
+                    n.childCount <= nodeCount_ - n.firstChild);
+        }
+
+        uint32_t nodeCount() const { return nodeCount_; }
+        uint32_t stringCount() const { return stringCount_; }
+        const Node &node(uint32_t i) const { return nodes_[i]; }
+        uint32_t childIndex(const Node &n, uint32_t k) const { return n.firstChild + k; }
+
+        const char *str(uint32_t id) const { return chars_ + offsets_[id]; }
+        uint32_t strLen(uint32_t id) const { return offsets_[id + 1] - offsets_[id] - 1; }
+
+        // Índices de las cadenas names[0..n) en ids (NONE si no están), en una
+        // sola pasada por la tabla: se usa una vez por carga para los nombres
+        // fijos ("Method", "name"...), luego se comparan índices.
+        void findStrings(const char *const *names, uint32_t *ids, size_t n) const {
+            size_t left = n;
+            for (size_t k = 0; k < n; ++k) ids[k] = NONE;
+            for (uint32_t i = 0; i < stringCount_ && left > 0; ++i) {
+                if (!validString(i)) continue;
+                for (size_t k = 0; k < n; ++k) {
+                    if (ids[k] == NONE && std::strcmp(str(i), names[k]) == 0 &&
+                        strLen(i) == std::strlen(names[k])) {
+                        ids[k] = i;
+                        --left;
+                        break;
+                    }
+                }
+            }
+        }
+
+        uint32_t findString(const char *s) const {
+            uint32_t id;
+            findStrings(&s, &id, 1);
+            return id;
+        }
+
+        // Valor de la propiedad con clave 'key' (índice), o NONE
+        static uint32_t prop(const Node &n, uint32_t key) {
+            for (uint32_t p = 0; p < n.nprops; ++p)
+                if (n.key[p] == key) return n.value[p];
+            return NONE;
+        }
+
+    private:
+        const Node     *nodes_;
+        const uint32_t *offsets_;
+        const char     *chars_;
+        uint32_t nodeCount_;
+        uint32_t stringCount_;
+        uint32_t charsSize_;
+    };
+
+} // namespace AstBin
+
+#endif // AST_BINARY_H
@@ -0,0 +1,604 @@
+#include "evaluator.h"
+#include "ast_binary.h"
+#include "script_interpreter.h"
+#include "../engine/world.h"
+#include "../engine/log.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace Eval {
+
+    // Un While/For que pasa este número de vueltas se corta (con aviso) para
+    // que un script mal escrito no congele el frame
+    static const long MAX_LOOP_STEPS = 1000000;
+    // Profundidad máxima del árbol al compilar (un archivo corrupto no
+    // debe agotar la pila)
+    static const int MAX_DEPTH = 256;
+
+    // -----------------------------------------------------------------
+    // Valores
+    // -----------------------------------------------------------------
+
+    int Context::intern(const std::string &s) {
+        std::map<std::string, int>::iterator it = stringIndex->find(s);
+        if (it != stringIndex->end()) return it->second;
+        int idx = static_cast<int>(strings->size());
+        strings->push_back(s);
+        (*stringIndex)[s] = idx;
+        return idx;
+    }
+
+    const std::string &Context::str(const Value &v) const {
+        if (v.i >= 0) return (*strings)[v.i];
+        int k = -1 - v.i;
+        return (k & 1) ? runtime->vars[k >> 1] : runtime->sites[k >> 1];
+    }
+
+    Value Context::concat(int site, const Value &a, const Value &b) {
+        std::vector<std::string> &sites = runtime->sites;
+        if (static_cast<int>(sites.size()) <= site) sites.resize(site + 1);
+        std::string s = text(a);   // a o b pueden ser el texto de este mismo '+'
+        s += text(b);
+        sites[site].swap(s);
+        return Value(STR, -1 - 2 * site);
+    }
+
+    Value Context::own(int slot, const Value &v) {
+        if (v.kind != STR || v.i >= 0 || v.i == -2 - 2 * slot) return v;
+        std::vector<std::string> &vars = runtime->vars;
+        if (static_cast<int>(vars.size()) <= slot) vars.resize(slot + 1);
+        vars[slot] = str(v);
+        return Value(STR, -2 - 2 * slot);
+    }
+
+    std::string Context::text(const Value &v) const {
+        char buf[16];
+        switch (v.kind) {
+            case STR:  return str(v);
+            case BOOL: return v.i ? "true" : "false";
+            case INT:  std::sprintf(buf, "%d", v.i); return buf;
+            default:   return "";
+        }
+    }
+
+    int asInt(const Context &cx, const Value &v) {
+        if (v.kind == STR) return std::atoi(cx.str(v).c_str());
+        return v.i;   // INT, BOOL y NIL (0)
+    }
+
+    // -----------------------------------------------------------------
+    // Expresiones
+    // -----------------------------------------------------------------
+
+    class Const : public Expr {
+    public:
+        explicit Const(Value v) : v_(v) {}
+        Value eval(Context &) const { return v_; }
+    private:
+        Value v_;
+    };
+
+    class SlotRead : public Expr {
+    public:
+        explicit SlotRead(int slot) : slot_(slot) {}
+        Value eval(Context &cx) const { return (*cx.slots)[slot_]; }
+    private:
+        int slot_;
+    };
+
+    class ScoreRead : public Expr {
+    public:
+        Value eval(Context &cx) const { return Value(INT, cx.world->score()); }
+    };
+
+    class GameEndedRead : public Expr {
+    public:
+        Value eval(Context &cx) const { return Value(BOOL, cx.world->isGameEnded() ? 1 : 0); }
+    };
+
+    class Not : public Expr {
+    public:
+        explicit Not(Expr *e) : e_(e) {}
+        ~Not() { delete e_; }
+        Value eval(Context &cx) const { return Value(BOOL, truthy(e_->eval(cx)) ? 0 : 1); }
+    private:
+        Expr *e_;
+    };
+
+    class Neg : public Expr {
+    public:
+        explicit Neg(Expr *e) : e_(e) {}
+        ~Neg() { delete e_; }
+        Value eval(Context &cx) const { return Value(INT, -asInt(cx, e_->eval(cx))); }
+    private:
+        Expr *e_;
+    };
+
+    class And : public Expr {
+    public:
+        And(Expr *l, Expr *r) : l_(l), r_(r) {}
+        ~And() { delete l_; delete r_; }
+        Value eval(Context &cx) const {
+            return Value(BOOL, truthy(l_->eval(cx)) && truthy(r_->eval(cx)) ? 1 : 0);
+        }
+    private:
+        Expr *l_, *r_;
+    };
+
+    class Or : public Expr {
+    public:
+        Or(Expr *l, Expr *r) : l_(l), r_(r) {}
+        ~Or() { delete l_; delete r_; }
+        Value eval(Context &cx) const {
+            return Value(BOOL, truthy(l_->eval(cx)) || truthy(r_->eval(cx)) ? 1 : 0);
+        }
+    private:
+        Expr *l_, *r_;
+    };
+
+    // Operadores binarios: una clase por operador, con el caso entero en línea.
+    // AddOp solo pliega constantes (apply); al ejecutar, '+' es la clase Add.
+    struct AddOp {
+        static Value apply(Context &cx, const Value &a, const Value &b) {
+            if (a.kind == STR || b.kind == STR) return Value(STR, cx.intern(cx.text(a) + cx.text(b)));
+            return Value(INT, asInt(cx, a) + asInt(cx, b));
+        }
+    };
+    struct SubOp { static Value apply(Context &cx, const Value &a, const Value &b) { return Value(INT, asInt(cx, a) - asInt(cx, b)); } };
+    struct MulOp { static Value apply(Context &cx, const Value &a, const Value &b) { return Value(INT, asInt(cx, a) * asInt(cx, b)); } };
+    struct LtOp  { static Value apply(Context &cx, const Value &a, const Value &b) { return Value(BOOL, asInt(cx, a) <  asInt(cx, b)); } };
+    struct GtOp  { static Value apply(Context &cx, const Value &a, const Value &b) { return Value(BOOL, asInt(cx, a) >  asInt(cx, b)); } };
+    struct LeOp  { static Value apply(Context &cx, const Value &a, const Value &b) { return Value(BOOL, asInt(cx, a) <= asInt(cx, b)); } };
+    struct GeOp  { static Value apply(Context &cx, const Value &a, const Value &b) { return Value(BOOL, asInt(cx, a) >= asInt(cx, b)); } };
+
+    // Las del programa están internadas: dos iguales tienen el mismo índice.
+    // Las armadas al ejecutar se comparan por texto.
+    static bool equal(Context &cx, const Value &a, const Value &b) {
+        if (a.kind == STR && b.kind == STR && a.i >= 0 && b.i >= 0) return a.i == b.i;
+        if (a.kind == STR && b.kind == STR) return cx.str(a) == cx.str(b);
+        if (a.kind == STR || b.kind == STR) return cx.text(a) == cx.text(b);
+        return a.i == b.i;
+    }
+    struct EqOp { static Value apply(Context &cx, const Value &a, const Value &b) { return Value(BOOL, equal(cx, a, b)); } };
+    struct NeOp { static Value apply(Context &cx, const Value &a, const Value &b) { return Value(BOOL, !equal(cx, a, b)); } };
+
+    int binaryOp(const char *op) {
+        static const char *const names[] = { "+", "-", "*", "<", ">", "<=", ">=", "==", "!=", "&&", "||" };
+        for (int i = 0; i < BAD_OP; ++i)
+            if (std::strcmp(names[i], op) == 0) return i;
+        return BAD_OP;
+    }
+
+    Value apply(int op, Context &cx, const Value &a, const Value &b) {
+        switch (op) {
+            case ADD: return AddOp::apply(cx, a, b);
+            case SUB: return SubOp::apply(cx, a, b);
+            case MUL: return MulOp::apply(cx, a, b);
+            case LT:  return LtOp::apply(cx, a, b);
+            case GT:  return GtOp::apply(cx, a, b);
+            case LE:  return LeOp::apply(cx, a, b);
+            case GE:  return GeOp::apply(cx, a, b);
+            case EQ:  return EqOp::apply(cx, a, b);
+            case NE:  return NeOp::apply(cx, a, b);
+            case AND: return Value(BOOL, truthy(a) && truthy(b));
+            case OR:  return Value(BOOL, truthy(a) || truthy(b));
+            default:  return Value();
+        }
+    }
+
+    template <class Op>
+    class Binary : public Expr {
+    public:
+        Binary(Expr *l, Expr *r) : l_(l), r_(r) {}
+        ~Binary() { delete l_; delete r_; }
+        Value eval(Context &cx) const {
+            Value a = l_->eval(cx);
+            return Op::apply(cx, a, r_->eval(cx));
+        }
+    private:
+        Expr *l_, *r_;
+    };
+
+    // '+' con su propio texto para cuando concatena cadenas
+    class Add : public Expr {
+    public:
+        Add(Expr *l, Expr *r, int site) : l_(l), r_(r), site_(site) {}
+        ~Add() { delete l_; delete r_; }
+        Value eval(Context &cx) const {
+            Value a = l_->eval(cx);
+            Value b = r_->eval(cx);
+            if (a.kind == STR || b.kind == STR) return cx.concat(site_, a, b);
+            return Value(INT, asInt(cx, a) + asInt(cx, b));
+        }
+    private:
+        Expr *l_, *r_;
+        int site_;
+    };
+
+    // -----------------------------------------------------------------
+    // Sentencias
+    // -----------------------------------------------------------------
+
+    class Seq : public Stmt {
+    public:
+        ~Seq() { for (size_t i = 0; i < body_.size(); ++i) delete body_[i]; }
+        void add(Stmt *s) { body_.push_back(s); }
+        bool exec(Context &cx) const {
+            for (size_t i = 0; i < body_.size(); ++i)
+                if (!body_[i]->exec(cx)) return false;
+            return true;
+        }
+    private:
+        std::vector<Stmt*> body_;
+    };
+
+    class Assign : public Stmt {
+    public:
+        Assign(int slot, Expr *e) : slot_(slot), e_(e) {}
+        ~Assign() { delete e_; }
+        bool exec(Context &cx) const { cx.store(slot_, e_->eval(cx)); return true; }
+    private:
+        int slot_;
+        Expr *e_;
+    };
+
+    class Print : public Stmt {
+    public:
+        explicit Print(Expr *e) : e_(e) {}
+        ~Print() { delete e_; }
+        bool exec(Context &cx) const {
+            LOG_INFO(INTERPRETER, cx.text(e_->eval(cx)));
+            return true;
+        }
+    private:
+        Expr *e_;
+    };
+
+    class If : public Stmt {
+    public:
+        If(Expr *c, Stmt *t, Stmt *e) : c_(c), t_(t), e_(e) {}
+        ~If() { delete c_; delete t_; delete e_; }
+        bool exec(Context &cx) const {
+            if (truthy(c_->eval(cx))) return t_->exec(cx);
+            return e_ ? e_->exec(cx) : true;
+        }
+    private:
+        Expr *c_;
+        Stmt *t_, *e_;
+    };
+
+    static void loopLimit(const char *what) {
+        LOG_WARN(INTERPRETER, what << " cortado tras " << MAX_LOOP_STEPS << " vueltas");
+    }
+
+    class While : public Stmt {
+    public:
+        While(Expr *c, Stmt *b) : c_(c), b_(b) {}
+        ~While() { delete c_; delete b_; }
+        bool exec(Context &cx) const {
+            for (long n = 0; truthy(c_->eval(cx)); ++n) {
+                if (n == MAX_LOOP_STEPS) { loopLimit("while"); break; }
+                if (!b_->exec(cx)) return false;
+            }
+            return true;
+        }
+    private:
+        Expr *c_;
+        Stmt *b_;
+    };
+
+    // Las partes de for (init; cond; update) pueden faltar
+    class For : public Stmt {
+    public:
+        For(Stmt *i, Expr *c, Stmt *u, Stmt *b) : i_(i), c_(c), u_(u), b_(b) {}
+        ~For() { delete i_; delete c_; delete u_; delete b_; }
+        bool exec(Context &cx) const {
+            if (i_ && !i_->exec(cx)) return false;
+            for (long n = 0; !c_ || truthy(c_->eval(cx)); ++n) {
+                if (n == MAX_LOOP_STEPS) { loopLimit("for"); break; }
+                if (!b_->exec(cx)) return false;
+                if (u_ && !u_->exec(cx)) return false;
+            }
+            return true;
+        }
+    private:
+        Stmt *i_;
+        Expr *c_;
+        Stmt *u_, *b_;
+    };
+
+    class Return : public Stmt {
+    public:
+        bool exec(Context &) const { return false; }
+    };
+
+    // Comando del motor con el OpCode ya resuelto; los argumentos son expresiones
+    class Call : public Stmt {
+    public:
+        Call(int op, int name) : op_(op), name_(name) { arg_[0] = arg_[1] = arg_[2] = NULL; }
+        ~Call() { delete arg_[0]; delete arg_[1]; delete arg_[2]; }
+        void setArg(int k, Expr *e) { arg_[k] = e; }
+
+        bool exec(Context &cx) const {
+            Engine::World &w = *cx.world;
+            switch (op_) {
+                case OP_SPAWN_BLOCK:   w.spawnBlock(str(cx, 0), num(cx, 1), num(cx, 2)); break;
+                case OP_MOVE_ENTITY:   { int id = num(cx, 0), dx = num(cx, 1); w.moveEntity(id, dx, num(cx, 2)); } break;
+                case OP_ROTATE_ENTITY: w.rotateEntity(num(cx, 0)); break;
+                case OP_DROP_ENTITY:   w.dropEntity(num(cx, 0)); break;
+                case OP_ADD_SCORE:     w.addScore(num(cx, 0)); break;
+                case OP_SET_SCORE:     w.setScore(num(cx, 0)); break;
+                case OP_END_GAME:      w.endGame(str(cx, 0)); break;
+                case OP_DRAW_TEXT:     { std::string t = str(cx, 0); int x = num(cx, 1); w.drawText(t, x, num(cx, 2)); } break;
+                default:
+                    LOG_WARN(INTERPRETER, "Comando desconocido: " << (*cx.strings)[name_]);
+                    break;
+            }
+            return true;
+        }
+
+    private:
+        int op_;
+        int name_;
+        Expr *arg_[3];
+
+        int num(Context &cx, int k) const { return arg_[k] ? asInt(cx, arg_[k]->eval(cx)) : 0; }
+        std::string str(Context &cx, int k) const { return arg_[k] ? cx.text(arg_[k]->eval(cx)) : ""; }
+    };
+
+    // -----------------------------------------------------------------
+    // Compilación
+    // -----------------------------------------------------------------
+
+    void Names::find(const AstBin::View &ast) {
+        static const char *const names[] = {
+            "Class", "Method", "Attribute", "Call", "Print", "Assignment", "If", "While",
+            "For", "Return", "Block", "BinaryOp", "UnaryOp", "Number", "String", "Boolean",
+            "Null", "Ident", "name", "value", "op", "target", "type"
+        };
+        uint32_t *fields[] = {
+            &cls, &method, &attribute, &call, &print, &assignment, &ifNode, &whileNode,
+            &forNode, &returnNode, &block, &binary, &unary, &number, &string, &boolean,
+            &null, &ident, &name, &value, &op, &target, &type
+        };
+        const size_t n = sizeof(names) / sizeof(names[0]);
+        uint32_t ids[n];
+        ast.findStrings(names, ids, n);
+        for (size_t i = 0; i < n; ++i) *fields[i] = ids[i];
+    }
+
+    int Slots::slotFor(const std::string &name, std::vector<Value> &values) {
+        std::map<std::string, int>::iterator it = index.find(name);
+        if (it != index.end()) return it->second;
+        int slot = static_cast<int>(values.size());
+        values.push_back(Value());
+        index[name] = slot;
+        return slot;
+    }
+
+    bool isBuiltin(const char *name) {
+        return std::strcmp(name, "score") == 0 || std::strcmp(name, "gameEnded") == 0;
+    }
+
+    bool needsTree(const AstBin::View &ast, const Names &k, uint32_t methodNode) {
+        const AstBin::Node &m = ast.node(methodNode);
+        for (uint32_t c = 0; c < m.childCount; ++c) {
+            uint32_t ci = m.firstChild + c;
+            if (!ast.validNode(ci)) continue;
+            const AstBin::Node &call = ast.node(ci);
+            if (call.type != k.call) return true;
+            // Un argumento que no es literal (variable, operación) también
+            for (uint32_t a = 0; a < call.childCount; ++a) {
+                uint32_t ai = call.firstChild + a;
+                if (!ast.validNode(ai)) continue;
+                const AstBin::Node &arg = ast.node(ai);
+                bool literal = arg.type == k.number || arg.type == k.string ||
+                               (arg.type == k.unary && arg.childCount == 1 &&
+                                ast.validNode(arg.firstChild) && ast.node(arg.firstChild).type == k.number);
+                if (!literal) return true;
+            }
+        }
+        return false;
+    }
+
+    namespace {
+
+    class Compiler {
+    public:
+        Compiler(const AstBin::View &ast, const Names &k, Slots &slots, Context &cx)
+            : ok(true), ast_(ast), k_(k), slots_(slots), cx_(cx), depth_(0) {}
+
+        bool ok;
+
+        Stmt *block(uint32_t i) {
+            if (!enter(i)) return new Seq();
+            Stmt *s = blockNode(ast_.node(i));
+            --depth_;
+            return s;
+        }
+
+        Expr *expr(uint32_t i) {
+            if (!enter(i)) return new Const(Value());
+            const AstBin::Node &n = ast_.node(i);
+            Expr *e = exprNode(n);
+            --depth_;
+            return e;
+        }
+
+    private:
+        const AstBin::View &ast_;
+        const Names &k_;
+        Slots &slots_;
+        Context &cx_;
+        int depth_;
+
+        // Method y Block: sus hijos en orden
+        Stmt *blockNode(const AstBin::Node &n) {
+            Seq *seq = new Seq();
+            for (uint32_t c = 0; c < n.childCount; ++c) {
+                Stmt *s = stmt(n.firstChild + c);
+                if (s) seq->add(s);
+            }
+            return seq;
+        }
+
+        bool enter(uint32_t i) {
+            if (depth_ >= MAX_DEPTH || !ast_.validNode(i)) { ok = false; return false; }
+            ++depth_;
+            return true;
+        }
+
+        const char *prop(const AstBin::Node &n, uint32_t key) const {
+            uint32_t id = AstBin::View::prop(n, key);
+            return id == AstBin::NONE ? "" : ast_.str(id);
+        }
+
+        Expr *child(const AstBin::Node &n, uint32_t c) {
+            if (c >= n.childCount) return new Const(Value());
+            return expr(n.firstChild + c);
+        }
+
+        Expr *exprNode(const AstBin::Node &n) {
+            if (n.type == k_.number)  return new Const(Value(INT, std::atoi(prop(n, k_.value))));
+            if (n.type == k_.string)  return new Const(Value(STR, cx_.intern(prop(n, k_.value))));
+            if (n.type == k_.boolean) {
+                const char *v = prop(n, k_.value);
+                return new Const(Value(BOOL, (v[0] | 0x20) == 't' ? 1 : 0));   // true / TRUE
+            }
+            if (n.type == k_.ident) {
+                const char *name = prop(n, k_.name);
+                if (std::strcmp(name, "score") == 0) return new ScoreRead();
+                if (std::strcmp(name, "gameEnded") == 0) return new GameEndedRead();
+                return new SlotRead(slots_.slotFor(name, *cx_.slots));
+            }
+            if (n.type == k_.unary) {
+                const char *op = prop(n, k_.op);
+                Expr *e = child(n, 0);
+                if (std::strcmp(op, "!") == 0) return new Not(e);
+                return new Neg(e);
+            }
+            if (n.type == k_.binary) {
+                const char *op = prop(n, k_.op);
+                Expr *l = child(n, 0);
+                Expr *r = child(n, 1);
+                switch (binaryOp(op)) {
+                    case ADD: return new Add(l, r, cx_.runtime->newSite());
+                    case SUB: return new Binary<SubOp>(l, r);
+                    case MUL: return new Binary<MulOp>(l, r);
+                    case LT:  return new Binary<LtOp>(l, r);
+                    case GT:  return new Binary<GtOp>(l, r);
+                    case LE:  return new Binary<LeOp>(l, r);
+                    case GE:  return new Binary<GeOp>(l, r);
+                    case EQ:  return new Binary<EqOp>(l, r);
+                    case NE:  return new Binary<NeOp>(l, r);
+                    case AND: return new And(l, r);
+                    case OR:  return new Or(l, r);
+                }
+                delete l; delete r;
+                ok = false;
+                return new Const(Value());
+            }
+            return new Const(Value());   // Null, List
+        }
+
+        Stmt *assignment(const AstBin::Node &n) {
+            const char *target = prop(n, k_.target);
+            if (isBuiltin(target)) {
+                LOG_WARN(INTERPRETER, "'" << target << "' es de solo lectura; asignacion ignorada");
+                return NULL;
+            }
+            return new Assign(slots_.slotFor(target, *cx_.slots), child(n, 0));
+        }
+
+        Stmt *stmt(uint32_t i) {
+            if (!enter(i)) return NULL;
+            const AstBin::Node &n = ast_.node(i);
+            Stmt *s = stmtNode(n);
+            --depth_;
+            return s;
+        }
+
+        Stmt *stmtNode(const AstBin::Node &n) {
+            if (n.type == k_.assignment) return assignment(n);
+            if (n.type == k_.print) return new Print(child(n, 0));
+            if (n.type == k_.returnNode) return new Return();
+            if (n.type == k_.block) return blockNode(n);
+            if (n.type == k_.call) {
+                uint32_t nameId = AstBin::View::prop(n, k_.name);
+                const char *name = nameId == AstBin::NONE ? "" : ast_.str(nameId);
+                Call *c = new Call(commandOpcode(name), cx_.intern(name));
+                for (uint32_t a = 0; a < n.childCount && a < 3; ++a) c->setArg(a, child(n, a));
+                return c;
+            }
+            if (n.type == k_.ifNode) {
+                Expr *cond = child(n, 0);
+                Stmt *then = n.childCount > 1 ? stmt(n.firstChild + 1) : NULL;
+                Stmt *els  = n.childCount > 2 ? stmt(n.firstChild + 2) : NULL;
+                return new If(cond, then ? then : new Seq(), els);
+            }
+            if (n.type == k_.whileNode) {
+                Expr *cond = child(n, 0);
+                Stmt *body = n.childCount > 1 ? stmt(n.firstChild + 1) : NULL;
+                return new While(cond, body ? body : new Seq());
+            }
+            if (n.type == k_.forNode) return forLoop(n);
+            return NULL;   // comentarios ya no llegan; cualquier otra cosa se ignora
+        }
+
+        // Hijos de For: [init Assignment] [cond] [update Assignment] Block.
+        // Sin init, un update se lee como init (el AST no los distingue).
+        Stmt *forLoop(const AstBin::Node &n) {
+            if (n.childCount == 0) { ok = false; return NULL; }
+            uint32_t c = 0, last = n.childCount - 1;
+            Stmt *init = NULL, *update = NULL;
+            Expr *cond = NULL;
+            if (c < last && isType(n.firstChild + c, k_.assignment)) init = stmt(n.firstChild + c++);
+            if (c < last && !isType(n.firstChild + c, k_.assignment)) cond = expr(n.firstChild + c++);
+            if (c < last && isType(n.firstChild + c, k_.assignment)) update = stmt(n.firstChild + c++);
+            Stmt *body = stmt(n.firstChild + last);
+            return new For(init, cond, update, body ? body : new Seq());
+        }
+
+        bool isType(uint32_t i, uint32_t type) const {
+            return ast_.validNode(i) && ast_.node(i).type == type;
+        }
+    };
+
+    } // namespace
+
+    Body *compileMethod(const AstBin::View &ast, const Names &k, uint32_t methodNode,
+                        Slots &slots, Context &cx) {
+        Compiler comp(ast, k, slots, cx);
+        Stmt *root = comp.block(methodNode);
+        if (!comp.ok) {
+            delete root;
+            return NULL;
+        }
+        return new Body(root);
+    }
+
+    Value initialValue(const AstBin::View &ast, const Names &k, uint32_t attributeNode,
+                       Slots &slots, Context &cx) {
+        const AstBin::Node &a = ast.node(attributeNode);
+        // Init -> expresión
+        if (a.childCount > 0 && ast.validNode(a.firstChild)) {
+            const AstBin::Node &init = ast.node(a.firstChild);
+            if (init.childCount > 0) {
+                Compiler comp(ast, k, slots, cx);
+                Expr *e = comp.expr(init.firstChild);
+                Value v = comp.ok ? e->eval(cx) : Value();
+                delete e;
+                return v;
+            }
+        }
+        uint32_t typeId = AstBin::View::prop(a, k.type);
+        const char *type = typeId == AstBin::NONE ? "" : ast.str(typeId);
+        if (std::strcmp(type, "int") == 0)    return Value(INT, 0);
+        if (std::strcmp(type, "bool") == 0)   return Value(BOOL, 0);
+        if (std::strcmp(type, "string") == 0) return Value(STR, cx.intern(""));
+        return Value();
+    }
+
+} // namespace Eval
@@ -0,0 +1,135 @@
+#ifndef INTERPRETER_EVALUATOR_H
+#define INTERPRETER_EVALUATOR_H
+
+// Evaluador del lenguaje de Entrega1 (If, While, For, Assignment, BinaryOp,
+// UnaryOp, Print, Call...) sobre el AST que llega en un .astb.
+//
+// Cada método se compila una vez a un árbol de nodos ejecutables: cada
+// operador y cada sentencia es su propia clase, las variables son índices
+// de un arreglo (slots) y los comandos del motor ya tienen su OpCode. Al
+// ejecutar no se busca nada en mapas ni se comparan cadenas.
+
+#include "../engine/atomic_ops.h"
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Engine { class World; }
+namespace AstBin { class View; }
+
+namespace Eval {
+
+    enum Kind { NIL, INT, BOOL, STR };
+
+    // Valor del lenguaje; las cadenas son índices de la tabla del intérprete
+    struct Value {
+        int kind;
+        int i;
+        Value() : kind(NIL), i(0) {}
+        Value(int k, int v) : kind(k), i(v) {}
+    };
+
+    enum BinaryOp { ADD, SUB, MUL, LT, GT, LE, GE, EQ, NE, AND, OR, BAD_OP };
+
+    // Cadenas que se arman al ejecutar (concatenaciones). No entran en la
+    // tabla del programa, que no se poda: cada '+' del programa tiene su
+    // propio texto, que reutiliza en cada evaluación, y un resultado que se
+    // guarda en una variable se copia al texto de ese slot. Así la memoria
+    // depende del programa y no de los frames jugados. En un Value son
+    // índices negativos: -1 - 2*k para el '+' k y -2 - 2*slot para un slot.
+    struct RuntimeStrings {
+        std::vector<std::string> sites;
+        std::vector<std::string> vars;
+        int newSite() { sites.push_back(std::string()); return static_cast<int>(sites.size()) - 1; }
+        void clear() { sites.clear(); vars.clear(); }
+    };
+
+    // Lo que cambia de un intérprete (o de una copia) a otro: el mundo, las
+    // variables y la tabla de cadenas. El árbol compilado es de solo lectura.
+    struct Context {
+        Engine::World *world;
+        std::vector<Value> *slots;
+        std::vector<std::string> *strings;
+        std::map<std::string, int> *stringIndex;
+        RuntimeStrings *runtime;
+
+        int intern(const std::string &s);   // tabla del programa: solo al compilar
+        std::string text(const Value &v) const;
+        const std::string &str(const Value &v) const;   // v.kind == STR
+
+        Value concat(int site, const Value &a, const Value &b);   // en el texto del '+'
+        // Valor para guardar en el slot: una cadena armada al ejecutar se
+        // copia al texto del slot, así el '+' puede reutilizar el suyo
+        Value own(int slot, const Value &v);
+        void  store(int slot, const Value &v) { (*slots)[slot] = own(slot, v); }
+    };
+
+    // Semántica de los valores y operadores; la usan también el VM
+    // (register_vm.cpp) y su plegado de constantes
+    int   asInt(const Context &cx, const Value &v);
+    inline bool truthy(const Value &v) { return v.kind == STR || v.i != 0; }
+    int   binaryOp(const char *op);                                       // BAD_OP si no existe
+    // AND/OR sin cortocircuito. Para el plegado: ADD con cadenas interna el
+    // resultado en la tabla del programa (al ejecutar se usa concat)
+    Value apply(int op, Context &cx, const Value &a, const Value &b);
+    bool  isBuiltin(const char *name);                                    // "score", "gameEnded"
+
+    class Expr {
+    public:
+        virtual ~Expr() {}
+        virtual Value eval(Context &cx) const = 0;
+    };
+
+    class Stmt {
+    public:
+        virtual ~Stmt() {}
+        virtual bool exec(Context &cx) const = 0;   // false: se ejecutó un 'return'
+    };
+
+    // Cuerpo compilado de un método; lo comparten las copias de un Method
+    class Body {
+    public:
+        explicit Body(Stmt *root) : root_(root), refs_(1) {}
+        void run(Context &cx) const { root_->exec(cx); }
+        void retain() const { Engine::atomicAdd(&refs_, 1); }
+        void release() const { if (Engine::atomicAdd(&refs_, -1) == 1) delete this; }
+    private:
+        Stmt *root_;
+        mutable Engine::AtomicLong refs_;
+        ~Body() { delete root_; }
+        Body(const Body&);
+        Body& operator=(const Body&);
+    };
+
+    // Índices de los tipos de nodo y claves que usa el compilador dentro de
+    // la tabla de cadenas de un .astb (NONE si el archivo no los usa)
+    struct Names {
+        uint32_t cls, method, attribute, call, print, assignment, ifNode, whileNode,
+                 forNode, returnNode, block, binary, unary, number, string, boolean,
+                 null, ident, name, value, op, target, type;
+        void find(const AstBin::View &ast);
+    };
+
+    // Variables del programa: nombre -> slot. Las de solo lectura del motor
+    // ("score", "gameEnded") no ocupan slot.
+    struct Slots {
+        std::map<std::string, int> index;
+        int slotFor(const std::string &name, std::vector<Value> &values);
+    };
+
+    // ¿Tiene el método algo más que llamadas? (si no, basta el bytecode plano)
+    bool needsTree(const AstBin::View &ast, const Names &k, uint32_t methodNode);
+
+    // Compila el nodo Method. Devuelve NULL si el árbol está corrupto.
+    Body *compileMethod(const AstBin::View &ast, const Names &k, uint32_t methodNode,
+                        Slots &slots, Context &cx);
+
+    // Valor inicial de un Attribute (su Init, o el cero de su tipo)
+    Value initialValue(const AstBin::View &ast, const Names &k, uint32_t attributeNode,
+                       Slots &slots, Context &cx);
+
+} // namespace Eval
+
+#endif // INTERPRETER_EVALUATOR_H
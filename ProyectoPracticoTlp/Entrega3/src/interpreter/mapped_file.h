@@ -0,0 +1,32 @@
+#ifndef INTERPRETER_MAPPED_FILE_H
+#define INTERPRETER_MAPPED_FILE_H
+
+// Archivo completo mapeado en memoria, de solo lectura (mmap en POSIX,
+// CreateFileMapping/MapViewOfFile en Windows), para C++98.
+
+#include <cstddef>
+#include <string>
+
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    bool open(const std::string &path);
+    void close();
+
+    const char *data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char *data_;
+    size_t size_;
+#ifdef _WIN32
+    void *mapping_;   // HANDLE
+#endif
+
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+};
+
+#endif // INTERPRETER_MAPPED_FILE_H
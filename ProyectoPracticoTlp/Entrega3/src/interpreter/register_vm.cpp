@@ -0,0 +1,643 @@
+#include "register_vm.h"
+#include "ast_binary.h"
+#include "script_interpreter.h"
+#include "../engine/world.h"
+#include "../engine/log.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+
+namespace Vm {
+
+    using Eval::Value;
+
+    // Los mismos topes que el evaluador de árbol
+    static const long MAX_LOOP_STEPS = 1000000;
+    static const int  MAX_DEPTH = 256;
+    // Registros en la pila de run(); con más se usa un vector
+    static const int  LOCAL_REGS = 32;
+
+    // -----------------------------------------------------------------
+    // Ejecución
+    // -----------------------------------------------------------------
+
+    static inline int num(const Eval::Context &cx, const Value &v) {
+        return v.kind == Eval::STR ? Eval::asInt(cx, v) : v.i;
+    }
+
+    static inline bool same(Eval::Context &cx, const Value &a, const Value &b) {
+        if (a.kind != Eval::STR && b.kind != Eval::STR) return a.i == b.i;
+        return Eval::apply(Eval::EQ, cx, a, b).i != 0;
+    }
+
+    static void call(Eval::Context &cx, int cmd, const Value *arg, int argc) {
+        Engine::World &w = *cx.world;
+        int n[3];
+        for (int k = 0; k < 3; ++k) n[k] = k < argc ? num(cx, arg[k]) : 0;
+        switch (cmd) {
+            case OP_SPAWN_BLOCK:   w.spawnBlock(argc > 0 ? cx.text(arg[0]) : "", n[1], n[2]); break;
+            case OP_MOVE_ENTITY:   w.moveEntity(n[0], n[1], n[2]); break;
+            case OP_ROTATE_ENTITY: w.rotateEntity(n[0]); break;
+            case OP_DROP_ENTITY:   w.dropEntity(n[0]); break;
+            case OP_ADD_SCORE:     w.addScore(n[0]); break;
+            case OP_SET_SCORE:     w.setScore(n[0]); break;
+            case OP_END_GAME:      w.endGame(argc > 0 ? cx.text(arg[0]) : ""); break;
+            case OP_DRAW_TEXT:     w.drawText(argc > 0 ? cx.text(arg[0]) : "", n[1], n[2]); break;
+        }
+    }
+
+    long Program::run(Eval::Context &cx) const {
+        Value local[LOCAL_REGS];
+        std::vector<Value> heap;
+        Value *r = local;
+        if (nregs_ > LOCAL_REGS) {
+            heap.resize(nregs_);
+            r = &heap[0];
+        }
+        std::vector<Value> &slots = *cx.slots;
+        const size_t nv = varSlots_.size();
+        for (size_t i = 0; i < nv; ++i) r[i] = slots[varSlots_[i]];
+        for (size_t k = 0; k < consts_.size(); ++k) r[nv + k] = consts_[k];
+
+        const Instr *code = &code_[0];
+        const Instr *pc = code;
+        long steps = 0;
+        for (;;) {
+            const Instr &in = *pc++;
+            ++steps;
+            switch (in.op) {
+                // Una cadena armada al ejecutar que llega a una variable se
+                // copia al texto del slot (el ADD reutiliza el suyo)
+                case MOV:
+                    r[in.d] = r[in.a];
+                    if (r[in.d].kind == Eval::STR && static_cast<size_t>(in.d) < nv)
+                        r[in.d] = cx.own(varSlots_[in.d], r[in.d]);
+                    break;
+                case ADD:
+                    if (r[in.a].kind != Eval::STR && r[in.b].kind != Eval::STR) {
+                        r[in.d] = Value(Eval::INT, r[in.a].i + r[in.b].i);
+                    } else {
+                        r[in.d] = cx.concat(sites_[pc - 1 - code], r[in.a], r[in.b]);
+                        if (static_cast<size_t>(in.d) < nv) r[in.d] = cx.own(varSlots_[in.d], r[in.d]);
+                    }
+                    break;
+                case SUB: r[in.d] = Value(Eval::INT,  num(cx, r[in.a]) -  num(cx, r[in.b])); break;
+                case MUL: r[in.d] = Value(Eval::INT,  num(cx, r[in.a]) *  num(cx, r[in.b])); break;
+                case LT:  r[in.d] = Value(Eval::BOOL, num(cx, r[in.a]) <  num(cx, r[in.b])); break;
+                case GT:  r[in.d] = Value(Eval::BOOL, num(cx, r[in.a]) >  num(cx, r[in.b])); break;
+                case LE:  r[in.d] = Value(Eval::BOOL, num(cx, r[in.a]) <= num(cx, r[in.b])); break;
+                case GE:  r[in.d] = Value(Eval::BOOL, num(cx, r[in.a]) >= num(cx, r[in.b])); break;
+                case EQ:  r[in.d] = Value(Eval::BOOL,  same(cx, r[in.a], r[in.b])); break;
+                case NE:  r[in.d] = Value(Eval::BOOL, !same(cx, r[in.a], r[in.b])); break;
+                case NOT:   r[in.d] = Value(Eval::BOOL, !Eval::truthy(r[in.a])); break;
+                case NEG:   r[in.d] = Value(Eval::INT, -num(cx, r[in.a])); break;
+                case TRUTH: r[in.d] = Value(Eval::BOOL, Eval::truthy(r[in.a])); break;
+                case SCORE: r[in.d] = Value(Eval::INT, cx.world->score()); break;
+                case ENDED: r[in.d] = Value(Eval::BOOL, cx.world->isGameEnded()); break;
+                case JMP:  pc = code + in.d; break;
+                case JF:   if (!Eval::truthy(r[in.a])) pc = code + in.d; break;
+                case JT:   if (Eval::truthy(r[in.a]))  pc = code + in.d; break;
+                case JNLT: if (!(num(cx, r[in.a]) <  num(cx, r[in.b]))) pc = code + in.d; break;
+                case JNGT: if (!(num(cx, r[in.a]) >  num(cx, r[in.b]))) pc = code + in.d; break;
+                case JNLE: if (!(num(cx, r[in.a]) <= num(cx, r[in.b]))) pc = code + in.d; break;
+                case JNGE: if (!(num(cx, r[in.a]) >= num(cx, r[in.b]))) pc = code + in.d; break;
+                case JNEQ: if (!same(cx, r[in.a], r[in.b])) pc = code + in.d; break;
+                case JNNE: if (same(cx, r[in.a], r[in.b]))  pc = code + in.d; break;
+                case LINIT: r[in.d] = Value(Eval::INT, 0); break;
+                case LCHK:
+                    if (r[in.a].i == MAX_LOOP_STEPS) {
+                        LOG_WARN(INTERPRETER, (in.b ? "for" : "while") << " cortado tras " << MAX_LOOP_STEPS << " vueltas");
+                        pc = code + in.d;
+                    } else {
+                        ++r[in.a].i;
+                    }
+                    break;
+                case CALL:  call(cx, in.d, r + in.a, in.b); break;
+                case WARN:  LOG_WARN(INTERPRETER, "Comando desconocido: " << (*cx.strings)[in.b]); break;
+                case PRINT: LOG_INFO(INTERPRETER, cx.text(r[in.a])); break;
+                case RET:   goto done;
+            }
+        }
+    done:
+        for (size_t i = 0; i < nv; ++i) slots[varSlots_[i]] = r[i];
+        return steps;
+    }
+
+    // -----------------------------------------------------------------
+    // Compilación
+    // -----------------------------------------------------------------
+
+    // Mientras se compila, los registros se numeran por clase; finish() los
+    // pasa a la posición final [variables][constantes][temporales]
+    static const int K_BASE = 1 << 20;
+    static const int T_BASE = 1 << 21;
+
+    // Qué campos de cada instrucción son registros (1: d, 2: a, 4: b)
+    static int registerFields(int op) {
+        switch (op) {
+            case MOV: case NOT: case NEG: case TRUTH: return 1 | 2;
+            case SCORE: case ENDED: case LINIT:     return 1;
+            case JF: case JT: case LCHK: case CALL: case PRINT: return 2;
+            case JNLT: case JNGT: case JNLE: case JNGE: case JNEQ: case JNNE: return 2 | 4;
+            case JMP: case WARN: case RET:          return 0;
+            default:                                return 1 | 2 | 4;   // ADD..NE
+        }
+    }
+
+    class Lowering {
+    public:
+        Lowering(const AstBin::View &ast, const Eval::Names &k, Eval::Slots &slots,
+                 Eval::Context &cx, const Options &opts, Program &p)
+            : ok(true), ast_(ast), k_(k), slots_(slots), cx_(cx), opts_(opts), p_(p),
+              temps_(0), maxTemps_(0), depth_(0) {}
+
+        bool ok;
+
+        void method(uint32_t m) {
+            if (enter(m)) {
+                blockNode(ast_.node(m));
+                --depth_;
+            }
+            emit(RET, 0, 0, 0);
+            finish();
+        }
+
+    private:
+        // Resultado de una expresión: una constante (aún sin registro) o un registro
+        struct Operand {
+            bool isConst;
+            bool boolean;   // el registro ya tiene un BOOL (comparación, !, &&...)
+            Value v;
+            int reg;
+        };
+
+        const AstBin::View &ast_;
+        const Eval::Names &k_;
+        Eval::Slots &slots_;
+        Eval::Context &cx_;
+        const Options &opts_;
+        Program &p_;
+        std::map<int, int> vars_;                       // slot -> registro
+        std::map<std::pair<int, int>, int> consts_;     // (kind, i) -> registro
+        std::map<uint32_t, int> hoisted_;               // nodo -> registro calculado antes del ciclo
+        int temps_, maxTemps_;
+        int depth_;
+
+        static Operand constant(const Value &v) {
+            Operand o;
+            o.isConst = true;
+            o.boolean = v.kind == Eval::BOOL;
+            o.v = v;
+            o.reg = -1;
+            return o;
+        }
+        static Operand inReg(int r, bool boolean = false) {
+            Operand o;
+            o.isConst = false;
+            o.boolean = boolean;
+            o.reg = r;
+            return o;
+        }
+
+        bool enter(uint32_t i) {
+            if (depth_ >= MAX_DEPTH || !ast_.validNode(i)) { ok = false; return false; }
+            ++depth_;
+            return true;
+        }
+
+        const char *prop(const AstBin::Node &n, uint32_t key) const {
+            uint32_t id = AstBin::View::prop(n, key);
+            return id == AstBin::NONE ? "" : ast_.str(id);
+        }
+
+        bool isType(uint32_t i, uint32_t type) const {
+            return ast_.validNode(i) && ast_.node(i).type == type;
+        }
+
+        // --- registros e instrucciones ---
+
+        int varReg(const char *name) {
+            int slot = slots_.slotFor(name, *cx_.slots);
+            std::map<int, int>::iterator it = vars_.find(slot);
+            if (it != vars_.end()) return it->second;
+            int r = static_cast<int>(p_.varSlots_.size());
+            p_.varSlots_.push_back(slot);
+            vars_[slot] = r;
+            return r;
+        }
+
+        int constReg(const Value &v) {
+            std::pair<int, int> key(v.kind, v.i);
+            std::map<std::pair<int, int>, int>::iterator it = consts_.find(key);
+            if (it != consts_.end()) return it->second;
+            int r = K_BASE + static_cast<int>(p_.consts_.size());
+            p_.consts_.push_back(v);
+            consts_[key] = r;
+            return r;
+        }
+
+        int reg(const Operand &o) { return o.isConst ? constReg(o.v) : o.reg; }
+
+        int temp() {
+            int t = T_BASE + temps_++;
+            if (temps_ > maxTemps_) maxTemps_ = temps_;
+            return t;
+        }
+
+        size_t emit(int op, int d, int a, int b) {
+            Instr in;
+            in.op = op;
+            in.d  = d;
+            in.a  = a;
+            in.b  = b;
+            p_.code_.push_back(in);
+            return p_.code_.size() - 1;
+        }
+
+        // El salto en 'at' va a la próxima instrucción
+        void patch(size_t at) { p_.code_[at].d = static_cast<int>(p_.code_.size()); }
+
+        void moveInto(int dst, const Operand &o) {
+            if (o.isConst || o.reg != dst) emit(MOV, dst, reg(o), 0);
+        }
+
+        void finish() {
+            const int nv = static_cast<int>(p_.varSlots_.size());
+            const int nk = static_cast<int>(p_.consts_.size());
+            p_.sites_.assign(p_.code_.size(), -1);
+            for (size_t i = 0; i < p_.code_.size(); ++i) {
+                Instr &in = p_.code_[i];
+                int fields = registerFields(in.op);
+                if (fields & 1) in.d = place(in.d, nv, nk);
+                if (fields & 2) in.a = place(in.a, nv, nk);
+                if (fields & 4) in.b = place(in.b, nv, nk);
+                if (in.op == ADD) p_.sites_[i] = cx_.runtime->newSite();
+            }
+            p_.nregs_ = nv + nk + maxTemps_;
+        }
+
+        static int place(int r, int nv, int nk) {
+            if (r < K_BASE) return r;
+            if (r < T_BASE) return nv + (r - K_BASE);
+            return nv + nk + (r - T_BASE);
+        }
+
+        // --- expresiones ---
+
+        Operand child(const AstBin::Node &n, uint32_t c, int dst = -1) {
+            if (c >= n.childCount) return constant(Value());
+            return expr(n.firstChild + c, dst);
+        }
+
+        // Si dst >= 0 la última instrucción escribe ahí (asignaciones, argumentos)
+        Operand expr(uint32_t i, int dst = -1) {
+            if (!enter(i)) return constant(Value());
+            Operand o = exprNode(i, ast_.node(i), dst);
+            --depth_;
+            return o;
+        }
+
+        Operand exprNode(uint32_t i, const AstBin::Node &n, int dst) {
+            std::map<uint32_t, int>::iterator h = hoisted_.find(i);
+            if (h != hoisted_.end()) return inReg(h->second);
+
+            if (n.type == k_.number) return constant(Value(Eval::INT, std::atoi(prop(n, k_.value))));
+            if (n.type == k_.string) return constant(Value(Eval::STR, cx_.intern(prop(n, k_.value))));
+            if (n.type == k_.boolean) {
+                const char *v = prop(n, k_.value);
+                return constant(Value(Eval::BOOL, (v[0] | 0x20) == 't' ? 1 : 0));
+            }
+            if (n.type == k_.ident) {
+                const char *name = prop(n, k_.name);
+                bool score = std::strcmp(name, "score") == 0;
+                if (score || std::strcmp(name, "gameEnded") == 0) {
+                    int d = dst >= 0 ? dst : temp();
+                    emit(score ? SCORE : ENDED, d, 0, 0);
+                    return inReg(d, !score);
+                }
+                return inReg(varReg(name));
+            }
+            if (n.type == k_.unary) {
+                bool isNot = std::strcmp(prop(n, k_.op), "!") == 0;
+                int mark = temps_;
+                Operand c = child(n, 0);
+                if (c.isConst && opts_.fold)
+                    return constant(isNot ? Value(Eval::BOOL, !Eval::truthy(c.v))
+                                          : Value(Eval::INT, -Eval::asInt(cx_, c.v)));
+                int a = reg(c);
+                temps_ = mark;
+                int d = dst >= 0 ? dst : temp();
+                emit(isNot ? NOT : NEG, d, a, 0);
+                return inReg(d, isNot);
+            }
+            if (n.type == k_.binary) {
+                int op = Eval::binaryOp(prop(n, k_.op));
+                if (op == Eval::BAD_OP) { ok = false; return constant(Value()); }
+                if (op == Eval::AND || op == Eval::OR) return logical(n, op);
+                int mark = temps_;
+                Operand l = child(n, 0);
+                Operand r = child(n, 1);
+                if (l.isConst && r.isConst && opts_.fold) return constant(Eval::apply(op, cx_, l.v, r.v));
+                int a = reg(l), b = reg(r);
+                temps_ = mark;
+                int d = dst >= 0 ? dst : temp();
+                emit(ADD + (op - Eval::ADD), d, a, b);
+                return inReg(d, op >= Eval::LT);
+            }
+            return constant(Value());   // Null, List
+        }
+
+        // d = bool(o); si o ya es BOOL basta copiarlo
+        void toBool(int d, const Operand &o) {
+            if (o.boolean) moveInto(d, o);
+            else emit(TRUTH, d, reg(o), 0);
+        }
+
+        // && y || como valor: d = bool(l); si ya decide, salta; si no, d = bool(r)
+        Operand logical(const AstBin::Node &n, int op) {
+            int mark = temps_;
+            Operand l = child(n, 0);
+            if (l.isConst && opts_.fold) {
+                bool lv = Eval::truthy(l.v);
+                if (op == Eval::AND ? !lv : lv) return constant(Value(Eval::BOOL, lv));
+                Operand r = child(n, 1);
+                if (r.isConst) return constant(Value(Eval::BOOL, Eval::truthy(r.v)));
+                temps_ = mark;
+                int d = temp();
+                toBool(d, r);
+                return inReg(d, true);
+            }
+            temps_ = mark;
+            int d = temp();
+            toBool(d, l);
+            size_t skip = emit(op == Eval::AND ? JF : JT, 0, d, 0);
+            toBool(d, child(n, 1));
+            patch(skip);
+            temps_ = mark + 1;
+            return inReg(d, true);
+        }
+
+        // ¿Se puede calcular al compilar? (sin variables ni score/gameEnded)
+        bool isConst(uint32_t i, int depth) const {
+            if (depth > MAX_DEPTH || !ast_.validNode(i)) return false;
+            const AstBin::Node &n = ast_.node(i);
+            if (n.type == k_.ident) return false;
+            if (n.type == k_.binary && Eval::binaryOp(prop(n, k_.op)) == Eval::BAD_OP) return false;
+            if (n.type == k_.binary || n.type == k_.unary)
+                for (uint32_t c = 0; c < n.childCount; ++c)
+                    if (!isConst(n.firstChild + c, depth + 1)) return false;
+            return true;
+        }
+
+        // Valor de la condición si se conoce al compilar
+        bool constCond(uint32_t cond, bool &value) {
+            if (!opts_.fold || !isConst(cond, 0)) return false;
+            Operand o = expr(cond);
+            value = Eval::truthy(o.v);
+            return true;
+        }
+
+        // Saltos (sin destino aún, se agregan a 'out') que se toman cuando
+        // bool(cond) == when; si no, se sigue de largo. && y || se bajan a
+        // saltos en cortocircuito y una comparación salta con una sola
+        // instrucción: "salta si a < b" es JNGE a, b.
+        void branch(uint32_t cond, bool when, std::vector<size_t> &out) {
+            if (!enter(cond)) return;
+            int mark = temps_;
+            const AstBin::Node &n = ast_.node(cond);
+            int op = n.type == k_.binary && !hoisted_.count(cond) ? Eval::binaryOp(prop(n, k_.op)) : Eval::BAD_OP;
+            bool isNot = n.type == k_.unary && !hoisted_.count(cond) && std::strcmp(prop(n, k_.op), "!") == 0;
+            bool value;
+            if (constCond(cond, value)) {
+                if (value == when) out.push_back(emit(JMP, 0, 0, 0));
+            } else if (isNot && n.childCount > 0) {
+                branch(n.firstChild, !when, out);
+            } else if ((op == Eval::AND || op == Eval::OR) && n.childCount == 2) {
+                // a && b salta por falso si cualquiera es falso; por verdadero,
+                // solo si a es verdadero y luego b también (|| al revés)
+                bool shortCircuit = op == Eval::OR;
+                if (when == shortCircuit) {
+                    branch(n.firstChild, when, out);
+                    branch(n.firstChild + 1, when, out);
+                } else {
+                    std::vector<size_t> skip;
+                    branch(n.firstChild, shortCircuit, skip);
+                    branch(n.firstChild + 1, when, out);
+                    for (size_t i = 0; i < skip.size(); ++i) patch(skip[i]);
+                }
+            } else if (op >= Eval::LT && op <= Eval::NE) {
+                static const int whenFalse[] = { JNLT, JNGT, JNLE, JNGE, JNEQ, JNNE };
+                static const int whenTrue[]  = { JNGE, JNLE, JNGT, JNLT, JNNE, JNEQ };
+                Operand l = child(n, 0);
+                Operand r = child(n, 1);
+                int k = op - Eval::LT;
+                out.push_back(emit(when ? whenTrue[k] : whenFalse[k], 0, reg(l), reg(r)));
+            } else {
+                Operand c = exprNode(cond, n, -1);
+                out.push_back(emit(when ? JT : JF, 0, reg(c), 0));
+            }
+            temps_ = mark;
+            --depth_;
+        }
+
+        void patchAll(const std::vector<size_t> &jumps) {
+            for (size_t i = 0; i < jumps.size(); ++i) patch(jumps[i]);
+        }
+
+        // Salta a 'target' (ya emitido) cuando bool(cond) == when
+        void branchTo(uint32_t cond, bool when, int target) {
+            std::vector<size_t> jumps;
+            branch(cond, when, jumps);
+            for (size_t i = 0; i < jumps.size(); ++i) p_.code_[jumps[i]].d = target;
+        }
+
+        // --- sentencias ---
+
+        void stmt(uint32_t i) {
+            if (!enter(i)) return;
+            int mark = temps_;
+            stmtNode(ast_.node(i));
+            temps_ = mark;
+            --depth_;
+        }
+
+        void blockNode(const AstBin::Node &n) {
+            for (uint32_t c = 0; c < n.childCount; ++c) stmt(n.firstChild + c);
+        }
+
+        void stmtNode(const AstBin::Node &n) {
+            if (n.type == k_.assignment)      assignment(n);
+            else if (n.type == k_.print)      emit(PRINT, 0, reg(child(n, 0)), 0);
+            else if (n.type == k_.returnNode) emit(RET, 0, 0, 0);
+            else if (n.type == k_.block)      blockNode(n);
+            else if (n.type == k_.call)       callStmt(n);
+            else if (n.type == k_.ifNode)     ifStmt(n);
+            else if (n.type == k_.whileNode)  whileStmt(n);
+            else if (n.type == k_.forNode)    forStmt(n);
+        }
+
+        void assignment(const AstBin::Node &n) {
+            const char *target = prop(n, k_.target);
+            if (Eval::isBuiltin(target)) {
+                LOG_WARN(INTERPRETER, "'" << target << "' es de solo lectura; asignacion ignorada");
+                return;
+            }
+            int v = varReg(target);
+            moveInto(v, child(n, 0, v));
+        }
+
+        // Los argumentos van en registros consecutivos desde 'base'
+        void callStmt(const AstBin::Node &n) {
+            const char *name = prop(n, k_.name);
+            int cmd = commandOpcode(name);
+            if (cmd == OP_UNKNOWN) {
+                emit(WARN, 0, 0, cx_.intern(name));
+                return;
+            }
+            int argc = static_cast<int>(n.childCount < 3 ? n.childCount : 3);
+            int base = T_BASE + temps_;
+            for (int a = 0; a < argc; ++a) temp();
+            for (int a = 0; a < argc; ++a) moveInto(base + a, child(n, a, base + a));
+            emit(CALL, cmd, base, argc);
+        }
+
+        void ifStmt(const AstBin::Node &n) {
+            if (n.childCount == 0) return;
+            bool value;
+            if (constCond(n.firstChild, value)) {
+                uint32_t live = value ? 1 : 2;        // la otra rama no se compila
+                if (live < n.childCount) stmt(n.firstChild + live);
+                return;
+            }
+            std::vector<size_t> toElse;
+            branch(n.firstChild, false, toElse);
+            if (n.childCount > 1) stmt(n.firstChild + 1);
+            if (n.childCount > 2) {
+                size_t toEnd = emit(JMP, 0, 0, 0);
+                patchAll(toElse);
+                stmt(n.firstChild + 2);
+                patch(toEnd);
+            } else {
+                patchAll(toElse);
+            }
+        }
+
+        void whileStmt(const AstBin::Node &n) {
+            if (n.childCount == 0) return;
+            uint32_t cond = n.firstChild;
+            bool value;
+            if (constCond(cond, value)) {
+                if (!value) return;
+                cond = AstBin::NONE;
+            }
+            loop(cond, AstBin::NONE, n.childCount > 1 ? n.firstChild + 1 : AstBin::NONE, 0);
+        }
+
+        // Hijos de For como en el evaluador: [init] [cond] [update] Block
+        void forStmt(const AstBin::Node &n) {
+            if (n.childCount == 0) { ok = false; return; }
+            uint32_t c = 0, last = n.childCount - 1;
+            uint32_t cond = AstBin::NONE, update = AstBin::NONE;
+            if (c < last && isType(n.firstChild + c, k_.assignment)) stmt(n.firstChild + c++);
+            if (c < last && !isType(n.firstChild + c, k_.assignment)) cond = n.firstChild + c++;
+            if (c < last && isType(n.firstChild + c, k_.assignment)) update = n.firstChild + c++;
+            bool value;
+            if (cond != AstBin::NONE && constCond(cond, value)) {
+                if (!value) return;
+                cond = AstBin::NONE;
+            }
+            loop(cond, update, n.firstChild + last, 1);
+        }
+
+        // La condición se prueba antes de entrar y al final de cada vuelta,
+        // así cada vuelta tiene un solo salto:
+        //   [invariantes]  LINIT c ; cond falsa -> exit
+        //   top: LCHK c -> exit ; body ; update ; cond verdadera -> top
+        //   exit:
+        void loop(uint32_t cond, uint32_t update, uint32_t body, int kind) {
+            int mark = temps_;
+            if (opts_.hoist) hoistLoop(cond, update, body);
+            int counter = temp();
+            emit(LINIT, counter, 0, 0);
+            std::vector<size_t> exits;
+            if (cond != AstBin::NONE) branch(cond, false, exits);
+            int top = static_cast<int>(p_.code_.size());
+            exits.push_back(emit(LCHK, 0, counter, kind));
+            if (body != AstBin::NONE) stmt(body);
+            if (update != AstBin::NONE) stmt(update);
+            if (cond != AstBin::NONE) branchTo(cond, true, top);
+            else emit(JMP, top, 0, 0);
+            patchAll(exits);
+            temps_ = mark;
+        }
+
+        // --- invariantes de ciclo ---
+
+        // Calcula antes del ciclo, en registros propios, cada subexpresión que
+        // no lee nada asignado dentro de él ni score/gameEnded (los cambian
+        // los comandos). Las expresiones no tienen efectos, así que da igual
+        // que alguna esté en una rama que no se ejecuta.
+        void hoistLoop(uint32_t cond, uint32_t update, uint32_t body) {
+            uint32_t parts[3] = { cond, update, body };
+            std::set<std::string> assigned;
+            for (int p = 0; p < 3; ++p)
+                if (parts[p] != AstBin::NONE) collectAssigned(parts[p], assigned, 0);
+            for (int p = 0; p < 3; ++p)
+                if (parts[p] != AstBin::NONE) hoistIn(parts[p], assigned, 0);
+        }
+
+        void collectAssigned(uint32_t i, std::set<std::string> &out, int depth) const {
+            if (depth > MAX_DEPTH || !ast_.validNode(i)) return;
+            const AstBin::Node &n = ast_.node(i);
+            if (n.type == k_.assignment) out.insert(prop(n, k_.target));
+            for (uint32_t c = 0; c < n.childCount; ++c) collectAssigned(n.firstChild + c, out, depth + 1);
+        }
+
+        bool invariant(uint32_t i, const std::set<std::string> &assigned, int depth) const {
+            if (depth > MAX_DEPTH || !ast_.validNode(i)) return false;
+            const AstBin::Node &n = ast_.node(i);
+            if (n.type == k_.ident) {
+                const char *name = prop(n, k_.name);
+                return !Eval::isBuiltin(name) && assigned.count(name) == 0;
+            }
+            for (uint32_t c = 0; c < n.childCount; ++c)
+                if (!invariant(n.firstChild + c, assigned, depth + 1)) return false;
+            return true;
+        }
+
+        void hoistIn(uint32_t i, const std::set<std::string> &assigned, int depth) {
+            if (depth > MAX_DEPTH || !ast_.validNode(i) || hoisted_.count(i)) return;
+            const AstBin::Node &n = ast_.node(i);
+            if ((n.type == k_.binary || n.type == k_.unary) && invariant(i, assigned, depth) &&
+                !(opts_.fold && isConst(i, depth))) {
+                int r = temp();
+                moveInto(r, expr(i, r));
+                hoisted_[i] = r;
+                return;
+            }
+            for (uint32_t c = 0; c < n.childCount; ++c) hoistIn(n.firstChild + c, assigned, depth + 1);
+        }
+    };
+
+    Program *compile(const AstBin::View &ast, const Eval::Names &k, uint32_t methodNode,
+                     Eval::Slots &slots, Eval::Context &cx, const Options &opts) {
+        Program *p = new Program();
+        Lowering low(ast, k, slots, cx, opts, *p);
+        low.method(methodNode);
+        if (!low.ok) {
+            delete p;
+            return NULL;
+        }
+        return p;
+    }
+
+    Eval::Body *compileMethod(const AstBin::View &ast, const Eval::Names &k, uint32_t methodNode,
+                              Eval::Slots &slots, Eval::Context &cx) {
+        Program *p = compile(ast, k, methodNode, slots, cx);
+        return p ? new Eval::Body(p) : NULL;
+    }
+
+} // namespace Vm
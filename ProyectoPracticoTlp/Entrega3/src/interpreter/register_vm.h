@@ -0,0 +1,84 @@
+#ifndef INTERPRETER_REGISTER_VM_H
+#define INTERPRETER_REGISTER_VM_H
+
+// Máquina de registros para los métodos del lenguaje de Entrega1. Es el
+// mismo lenguaje y la misma semántica que evaluator.h, pero cada método se
+// baja a instrucciones de tres direcciones (ADD d, a, b) sobre un arreglo
+// de registros:
+//
+//   [variables][constantes][temporales]
+//
+// - Las variables y los atributos de la clase tienen un registro fijo; al
+//   entrar al método se copian desde sus slots (los atributos ocupan los
+//   primeros, en el orden de la clase) y al salir se devuelven.
+// - Las constantes se pliegan al compilar (2 * 3 + x -> 6 + x) y un If con
+//   condición constante deja solo la rama que se ejecuta.
+// - Las subexpresiones de un While/For que no dependen de nada asignado
+//   dentro del ciclo se calculan una vez antes de entrar.
+// - Un If/While cuya condición es una comparación salta con una sola
+//   instrucción (JNLT a, b -> salida), sin armar el booleano.
+
+#include "evaluator.h"
+
+#include <vector>
+
+namespace Vm {
+
+    enum Op {
+        MOV,
+        ADD, SUB, MUL, LT, GT, LE, GE, EQ, NE,   // d = a <op> b
+        NOT, NEG, TRUTH,                         // d = !a, -a, bool(a)
+        SCORE, ENDED,                            // d = score / gameEnded del mundo
+        JMP,                                     // salta a d
+        JF, JT,                                  // salta a d si a es falso / verdadero
+        JNLT, JNGT, JNLE, JNGE, JNEQ, JNNE,      // salta a d si no se cumple a <op> b
+        LINIT,                                   // d = 0 (contador de vueltas)
+        LCHK,                                    // tope de vueltas del contador a: salta a d (b: 0 while, 1 for)
+        CALL,                                    // comando d con b argumentos desde el registro a
+        WARN,                                    // comando desconocido (b: su nombre)
+        PRINT,                                   // imprime a
+        RET
+    };
+
+    struct Instr {
+        int op;
+        int d;
+        int a;
+        int b;
+    };
+
+    // Qué optimizaciones aplica compile() (el benchmark las apaga para comparar)
+    struct Options {
+        bool fold;      // plegado de constantes y If/While con condición constante
+        bool hoist;     // subexpresiones invariantes fuera de los ciclos
+        Options() : fold(true), hoist(true) {}
+    };
+
+    class Program : public Eval::Stmt {
+    public:
+        Program() : nregs_(0) {}
+        bool exec(Eval::Context &cx) const { run(cx); return true; }
+        long run(Eval::Context &cx) const;    // devuelve las instrucciones ejecutadas
+        const std::vector<Instr> &code() const { return code_; }
+        int registers() const { return nregs_; }
+
+    private:
+        friend class Lowering;
+        std::vector<Instr> code_;
+        std::vector<Eval::Value> consts_;
+        std::vector<int> varSlots_;           // registro i <-> slot varSlots_[i]
+        std::vector<int> sites_;              // texto propio de cada ADD (Eval::RuntimeStrings)
+        int nregs_;
+    };
+
+    // Compila el nodo Method. Devuelve NULL si el árbol está corrupto.
+    Program *compile(const AstBin::View &ast, const Eval::Names &k, uint32_t methodNode,
+                     Eval::Slots &slots, Eval::Context &cx, const Options &opts = Options());
+
+    // Lo mismo, listo para Method::body
+    Eval::Body *compileMethod(const AstBin::View &ast, const Eval::Names &k, uint32_t methodNode,
+                              Eval::Slots &slots, Eval::Context &cx);
+
+} // namespace Vm
+
+#endif // INTERPRETER_REGISTER_VM_H
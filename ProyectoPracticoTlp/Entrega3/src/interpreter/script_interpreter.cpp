@@ -1,17 +1,19 @@
 #include "script_interpreter.h"
+#include "ast_binary.h"
+#include "register_vm.h"
+#include "mapped_file.h"
 #include "../engine/api.h"
+#include "../engine/world.h"
+#include "../engine/log.h"
+#include "../engine/atomic_ops.h"
+#include "../engine/frame_scheduler.h"
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <cstdlib>
+#include <cstring>
 
-#ifdef _WIN32
-#include <windows.h>
-#else
-#include <unistd.h>
-#endif
-
-ScriptInterpreter::ScriptInterpreter() {}
+ScriptInterpreter::ScriptInterpreter() : world(&Engine::defaultWorld()), image(NULL) {}
 
 static std::string trim(const std::string &s) {
     size_t start = s.find_first_not_of(" \t\r\n");
@@ -20,14 +22,29 @@ static std::string trim(const std::string &s) {
     return s.substr(start, end - start + 1);
 }
 
+static bool endsWith(const std::string &s, const char *suffix) {
+    size_t n = std::strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
 bool ScriptInterpreter::loadASTFile(const std::string &path) {
+    if (endsWith(path, ".astb")) return loadBinaryFile(path);
+    if (endsWith(path, ".json")) {
+#ifdef SCRIPT_JSON
+        return loadJSONFile(path);
+#else
+        std::cerr << "Este build no lee " << path << " (compilar con make JSON=1)\n";
+        return false;
+#endif
+    }
+
     std::ifstream f(path.c_str());
     if(!f.is_open()) {
         std::cerr << "No se pudo abrir " << path << "\n";
         return false;
     }
 
-    methods.clear();
+    resetProgram();
 
     std::string line;
     Method current;
@@ -39,7 +56,7 @@ bool ScriptInterpreter::loadASTFile(const std::string &path) {
 
         if (line[0] == '[' && line[line.size()-1] == ']') {
             if (hasCurrent) {
-                methods[current.name] = current;
+                methods.define(current.name) = current;
             }
             current = Method();
             current.name = line.substr(1, line.size() - 2);
@@ -59,10 +76,15 @@ bool ScriptInterpreter::loadASTFile(const std::string &path) {
     }
 
     if (hasCurrent) {
-        methods[current.name] = current;
+        methods.define(current.name) = current;
     }
 
-    std::cout << "[Interpreter] Script cargado. Metodos: " << methods.size() << "\n";
+    // Paso de compilación: cada comando se traduce una sola vez a bytecode
+    for (size_t i = 0; i < methods.size(); ++i) {
+        compileMethod(methods[i]);
+    }
+
+    LOG_INFO(INTERPRETER, "Script cargado. Metodos: " << methods.size());
     return !methods.empty();
 }
 
@@ -71,66 +93,486 @@ void ScriptInterpreter::executeCommand(const Command &cmd) {
         std::string type = cmd.args.size() > 0 ? cmd.args[0] : "";
         int x = cmd.args.size() > 1 ? std::atoi(cmd.args[1].c_str()) : 0;
         int y = cmd.args.size() > 2 ? std::atoi(cmd.args[2].c_str()) : 0;
-        Engine::spawnBlock(type, x, y);
+        world->spawnBlock(type, x, y);
     } else if (cmd.name == "moveEntity") {
         int id = cmd.args.size() > 0 ? std::atoi(cmd.args[0].c_str()) : 0;
         int dx = cmd.args.size() > 1 ? std::atoi(cmd.args[1].c_str()) : 0;
         int dy = cmd.args.size() > 2 ? std::atoi(cmd.args[2].c_str()) : 0;
-        Engine::moveEntity(id, dx, dy);
+        world->moveEntity(id, dx, dy);
     } else if (cmd.name == "rotateEntity") {
         int id = cmd.args.size() > 0 ? std::atoi(cmd.args[0].c_str()) : 0;
-        Engine::rotateEntity(id);
+        world->rotateEntity(id);
     } else if (cmd.name == "dropEntity") {
         int id = cmd.args.size() > 0 ? std::atoi(cmd.args[0].c_str()) : 0;
-        Engine::dropEntity(id);
+        world->dropEntity(id);
     } else if (cmd.name == "addScore") {
         int delta = cmd.args.size() > 0 ? std::atoi(cmd.args[0].c_str()) : 0;
-        Engine::addScore(delta);
+        world->addScore(delta);
     } else if (cmd.name == "setScore") {
         int v = cmd.args.size() > 0 ? std::atoi(cmd.args[0].c_str()) : 0;
-        Engine::setScore(v);
+        world->setScore(v);
     } else if (cmd.name == "endGame") {
         std::string reason = cmd.args.size() > 0 ? cmd.args[0] : "";
-        Engine::endGame(reason);
+        world->endGame(reason);
     } else if (cmd.name == "drawText") {
         std::string text = cmd.args.size() > 0 ? cmd.args[0] : "";
         int x = cmd.args.size() > 1 ? std::atoi(cmd.args[1].c_str()) : 0;
         int y = cmd.args.size() > 2 ? std::atoi(cmd.args[2].c_str()) : 0;
-        Engine::drawText(text, x, y);
+        world->drawText(text, x, y);
+    } else {
+        LOG_WARN(INTERPRETER, "Comando desconocido: " << cmd.name);
+    }
+}
+
+// ---------------------------------------------------------------------
+// Compilación a bytecode
+// ---------------------------------------------------------------------
+
+int ScriptInterpreter::internString(const std::string &s) {
+    std::map<std::string, int>::iterator it = stringIndex.find(s);
+    if (it != stringIndex.end()) return it->second;
+    int idx = static_cast<int>(strings.size());
+    strings.push_back(s);
+    stringIndex[s] = idx;
+    return idx;
+}
+
+static int intArg(const Command &cmd, size_t i) {
+    return cmd.args.size() > i ? std::atoi(cmd.args[i].c_str()) : 0;
+}
+
+static std::string strArg(const Command &cmd, size_t i) {
+    return cmd.args.size() > i ? cmd.args[i] : "";
+}
+
+Instr ScriptInterpreter::compileCommand(const Command &cmd) {
+    Instr in;
+    in.op  = OP_UNKNOWN;
+    in.a   = 0;
+    in.b   = 0;
+    in.c   = 0;
+    in.str = -1;
+
+    in.op = commandOpcode(cmd.name.c_str());
+    switch (in.op) {
+        case OP_SPAWN_BLOCK:
+            in.c = Engine::findSymbol(strArg(cmd, 0));
+            in.a = intArg(cmd, 1);
+            in.b = intArg(cmd, 2);
+            break;
+        case OP_MOVE_ENTITY:
+            in.a = intArg(cmd, 0);
+            in.b = intArg(cmd, 1);
+            in.c = intArg(cmd, 2);
+            break;
+        case OP_END_GAME:
+            in.str = internString(strArg(cmd, 0));
+            break;
+        case OP_DRAW_TEXT:
+            in.str = internString(strArg(cmd, 0));
+            in.a   = intArg(cmd, 1);
+            in.b   = intArg(cmd, 2);
+            break;
+        case OP_UNKNOWN:
+            // Se guarda el nombre para reportarlo al ejecutarse, como antes
+            in.str = internString(cmd.name);
+            break;
+        default:   // rotateEntity, dropEntity, addScore, setScore
+            in.a = intArg(cmd, 0);
+            break;
+    }
+    return in;
+}
+
+void ScriptInterpreter::compileMethod(Method &m) {
+    m.code.clear();
+    m.code.reserve(m.commands.size());
+    for (size_t i = 0; i < m.commands.size(); ++i) {
+        m.code.push_back(compileCommand(m.commands[i]));
+    }
+}
+
+void ScriptInterpreter::execute(const std::vector<Instr> &code) {
+    if (code.empty()) return;
+    const Instr *pc  = &code[0];
+    const Instr *end = pc + code.size();
+    for (; pc != end; ++pc) {
+        switch (pc->op) {
+            case OP_SPAWN_BLOCK:   world->spawnBlock(pc->c, pc->a, pc->b); break;
+            case OP_MOVE_ENTITY:   world->moveEntity(pc->a, pc->b, pc->c); break;
+            case OP_ROTATE_ENTITY: world->rotateEntity(pc->a); break;
+            case OP_DROP_ENTITY:   world->dropEntity(pc->a); break;
+            case OP_ADD_SCORE:     world->addScore(pc->a); break;
+            case OP_SET_SCORE:     world->setScore(pc->a); break;
+            case OP_END_GAME:      world->endGame(strings[pc->str]); break;
+            case OP_DRAW_TEXT:     world->drawText(strings[pc->str], pc->a, pc->b); break;
+            default:
+                LOG_WARN(INTERPRETER, "Comando desconocido: " << strings[pc->str]);
+                break;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------
+// AST binario (.astb)
+// ---------------------------------------------------------------------
+//
+// loadBinaryFile mapea el archivo y solo recorre Root -> Class -> Method para
+// armar la tabla de métodos; cada método se compila en su primera llamada.
+// Así la carga cuesta el mmap más un paso por método, sin importar cuántos
+// comandos tenga el programa. Un Call pasa directo a una Instr sin armar
+// Command: los argumentos son sus hijos (Number o String, y UnaryOp "neg"
+// para los negativos) y los nombres se comparan por índice de cadena. Los
+// métodos con algo más que llamadas de argumentos literales los compila
+// register_vm.cpp.
+
+// Los comandos son símbolos fijos en el orden de OpCode
+int commandOpcode(const char *name) {
+    Engine::Symbol s = Engine::findSymbol(name);
+    if (s < Engine::CMD_SPAWN_BLOCK || s > Engine::CMD_DRAW_TEXT) return OP_UNKNOWN;
+    return OP_SPAWN_BLOCK + (s - Engine::CMD_SPAWN_BLOCK);
+}
+
+// Archivo mapeado y los índices de sus cadenas fijas (NONE si no las usa).
+// Las copias del intérprete lo comparten; no se modifica después de cargar.
+struct BinaryImage {
+    MappedFile file;
+    AstBin::View ast;
+    Eval::Names k;
+    Engine::AtomicLong refs;
+
+    BinaryImage() : refs(1) {}
+
+    // Cadena de un argumento literal: su "value" (Number, String)
+    const char *text(const AstBin::Node *arg) const {
+        if (!arg) return "";
+        uint32_t id = AstBin::View::prop(*arg, k.value);
+        return id == AstBin::NONE ? "" : ast.str(id);
+    }
+
+    // Los nodos que llegan aquí ya pasaron validNode, incluido el hijo de un
+    // UnaryOp (needsTree deja en el bytecode plano solo el "neg" de un Number)
+    int number(const AstBin::Node *arg) const {
+        if (!arg) return 0;
+        if (arg->type == k.unary && arg->childCount == 1)
+            return -std::atoi(text(&ast.node(arg->firstChild)));
+        return std::atoi(text(arg));
+    }
+};
+
+Method::Method(const Method &other)
+    : name(other.name), commands(other.commands), code(other.code),
+      pending(other.pending), body(other.body) {
+    if (body) body->retain();
+}
+
+Method& Method::operator=(const Method &other) {
+    if (this != &other) {
+        if (other.body) other.body->retain();
+        if (body) body->release();
+        name     = other.name;
+        commands = other.commands;
+        code     = other.code;
+        pending  = other.pending;
+        body     = other.body;
+    }
+    return *this;
+}
+
+Method::~Method() {
+    if (body) body->release();
+}
+
+ScriptInterpreter::ScriptInterpreter(const ScriptInterpreter &other)
+    : world(other.world), methods(other.methods), strings(other.strings),
+      stringIndex(other.stringIndex), image(other.image), slots(other.slots),
+      slotNames(other.slotNames), runtime(other.runtime) {
+    if (image) Engine::atomicAdd(&image->refs, 1);
+}
+
+ScriptInterpreter& ScriptInterpreter::operator=(const ScriptInterpreter &other) {
+    if (this != &other) {
+        if (other.image) Engine::atomicAdd(&other.image->refs, 1);
+        releaseImage();
+        world       = other.world;
+        methods     = other.methods;
+        strings     = other.strings;
+        stringIndex = other.stringIndex;
+        image       = other.image;
+        slots       = other.slots;
+        slotNames   = other.slotNames;
+        runtime     = other.runtime;
+    }
+    return *this;
+}
+
+ScriptInterpreter::~ScriptInterpreter() {
+    releaseImage();
+}
+
+void ScriptInterpreter::releaseImage() {
+    if (image && Engine::atomicAdd(&image->refs, -1) == 1) delete image;
+    image = NULL;
+}
+
+// Antes de cargar otro programa
+void ScriptInterpreter::resetProgram() {
+    releaseImage();
+    methods.clear();
+    strings.clear();
+    stringIndex.clear();
+    slots.clear();
+    slotNames.index.clear();
+    runtime.clear();
+}
+
+Eval::Context ScriptInterpreter::context() {
+    Eval::Context cx;
+    cx.world       = world;
+    cx.slots       = &slots;
+    cx.strings     = &strings;
+    cx.stringIndex = &stringIndex;
+    cx.runtime     = &runtime;
+    return cx;
+}
+
+bool ScriptInterpreter::loadBinaryFile(const std::string &path) {
+    BinaryImage *img = new BinaryImage();
+    std::string why;
+    if (!img->file.open(path)) {
+        std::cerr << "No se pudo abrir " << path << "\n";
+        delete img;
+        return false;
+    }
+    if (!img->ast.open(img->file.data(), img->file.size(), why) || !img->ast.validNode(0)) {
+        std::cerr << path << ": " << (why.empty() ? "raiz corrupta" : why) << "\n";
+        delete img;
+        return false;
+    }
+    img->k.find(img->ast);
+
+    resetProgram();
+    image = img;
+
+    // Métodos sueltos bajo la raíz o dentro de una Class; los Attribute de
+    // la Class toman su valor inicial ahora, en orden
+    const AstBin::View &ast = img->ast;
+    const Eval::Names &k = img->k;
+    Eval::Context cx = context();
+    std::vector<uint32_t> found;
+    const AstBin::Node &root = ast.node(0);
+    for (uint32_t i = 0; i < root.childCount; ++i) {
+        uint32_t ci = ast.childIndex(root, i);
+        if (!ast.validNode(ci)) continue;
+        const AstBin::Node &n = ast.node(ci);
+        if (n.type == k.method) found.push_back(ci);
+        else if (n.type == k.cls)
+            for (uint32_t j = 0; j < n.childCount; ++j) {
+                uint32_t mi = ast.childIndex(n, j);
+                if (!ast.validNode(mi)) continue;
+                const AstBin::Node &member = ast.node(mi);
+                if (member.type == k.method) {
+                    found.push_back(mi);
+                } else if (member.type == k.attribute) {
+                    uint32_t attrName = AstBin::View::prop(member, k.name);
+                    if (attrName == AstBin::NONE) continue;
+                    Eval::Value v = Eval::initialValue(ast, k, mi, slotNames, cx);
+                    cx.store(slotNames.slotFor(ast.str(attrName), slots), v);
+                }
+            }
+    }
+
+    for (size_t i = 0; i < found.size(); ++i) {
+        uint32_t nameId = AstBin::View::prop(ast.node(found[i]), k.name);
+        if (nameId == AstBin::NONE) continue;
+        Method &m = methods.define(std::string(ast.str(nameId), ast.strLen(nameId)));
+        m.pending = static_cast<int>(found[i]);
+    }
+
+    LOG_INFO(INTERPRETER, "Script cargado (AST binario). Metodos: " << methods.size());
+    return !methods.empty();
+}
+
+void ScriptInterpreter::compileAll() {
+    for (size_t i = 0; i < methods.size(); ++i) {
+        if (methods[i].pending >= 0) compileBinary(methods[i]);
+    }
+}
+
+// Traduce los Call del nodo Method pendiente a bytecode, igual que
+// compileCommand; un método con control de flujo o expresiones pasa a la
+// máquina de registros (register_vm.h), o al evaluador de árbol si se
+// compiló con SCRIPT_TREE_EVAL (make EVAL=tree)
+void ScriptInterpreter::compileBinary(Method &m) {
+    const BinaryImage &img = *image;
+    const AstBin::View &ast = img.ast;
+    uint32_t mi = static_cast<uint32_t>(m.pending);
+    const AstBin::Node &mn = ast.node(mi);
+    m.pending = -1;
+
+    if (Eval::needsTree(ast, img.k, mi)) {
+        Eval::Context cx = context();
+#ifdef SCRIPT_TREE_EVAL
+        m.body = Eval::compileMethod(ast, img.k, mi, slotNames, cx);
+#else
+        m.body = Vm::compileMethod(ast, img.k, mi, slotNames, cx);
+#endif
+        if (!m.body) LOG_WARN(INTERPRETER, "Metodo " << m.name << ": AST binario corrupto, no se ejecuta");
+        return;
+    }
+
+    m.code.clear();
+    m.code.reserve(mn.childCount);
+    size_t skipped = 0;
+
+    for (uint32_t c = 0; c < mn.childCount; ++c) {
+        uint32_t ci = ast.childIndex(mn, c);
+        if (!ast.validNode(ci)) { ++skipped; continue; }
+        const AstBin::Node &call = ast.node(ci);
+        uint32_t callName = AstBin::View::prop(call, img.k.name);
+        if (call.type != img.k.call || callName == AstBin::NONE) { ++skipped; continue; }
+
+        const AstBin::Node *arg[3] = { NULL, NULL, NULL };
+        bool ok = true;
+        for (uint32_t a = 0; a < call.childCount && a < 3 && ok; ++a) {
+            uint32_t ai = ast.childIndex(call, a);
+            ok = ast.validNode(ai);
+            if (ok) {
+                arg[a] = &ast.node(ai);
+                if (arg[a]->childCount > 0) ok = ast.validNode(arg[a]->firstChild);
+            }
+        }
+        if (!ok) { ++skipped; continue; }
+
+        Instr in;
+        in.op  = commandOpcode(ast.str(callName));
+        in.a   = 0;
+        in.b   = 0;
+        in.c   = 0;
+        in.str = -1;
+        switch (in.op) {
+            case OP_SPAWN_BLOCK:
+                in.c = Engine::findSymbol(img.text(arg[0]));
+                in.a = img.number(arg[1]);
+                in.b = img.number(arg[2]);
+                break;
+            case OP_DRAW_TEXT:
+                in.str = internString(img.text(arg[0]));
+                in.a   = img.number(arg[1]);
+                in.b   = img.number(arg[2]);
+                break;
+            case OP_MOVE_ENTITY:
+                in.a = img.number(arg[0]);
+                in.b = img.number(arg[1]);
+                in.c = img.number(arg[2]);
+                break;
+            case OP_END_GAME:
+                in.str = internString(img.text(arg[0]));
+                break;
+            case OP_UNKNOWN:
+                in.str = internString(ast.str(callName));
+                break;
+            default:   // rotateEntity, dropEntity, addScore, setScore
+                in.a = img.number(arg[0]);
+                break;
+        }
+        m.code.push_back(in);
+    }
+
+    if (skipped > 0) {
+        LOG_WARN(INTERPRETER, "Metodo " << m.name << ": " << skipped << " instrucciones del AST binario ignoradas");
+    }
+}
+
+// ---------------------------------------------------------------------
+// Llamadas a métodos
+// ---------------------------------------------------------------------
+
+Method& MethodTable::define(const std::string &name) {
+    Engine::Symbol s = Engine::intern(name);
+    if (s >= static_cast<Engine::Symbol>(bySymbol_.size())) bySymbol_.resize(s + 1, -1);
+    if (bySymbol_[s] < 0) {
+        bySymbol_[s] = static_cast<int>(list_.size());
+        list_.push_back(Method());
     } else {
-        std::cout << "[Interpreter] Comando desconocido: " << cmd.name << "\n";
+        list_[bySymbol_[s]] = Method();
     }
+    Method &m = list_[bySymbol_[s]];
+    m.name = name;
+    return m;
+}
+
+Method* MethodTable::find(Engine::Symbol name) {
+    if (name < 0 || name >= static_cast<Engine::Symbol>(bySymbol_.size()) || bySymbol_[name] < 0) return NULL;
+    return &list_[bySymbol_[name]];
+}
+
+const Method* MethodTable::find(Engine::Symbol name) const {
+    return const_cast<MethodTable*>(this)->find(name);
+}
+
+const Method* ScriptInterpreter::findMethod(const std::string &methodName) const {
+    return methods.find(Engine::findSymbol(methodName));
 }
 
 void ScriptInterpreter::callMethod(const std::string &className, const std::string &methodName) {
     (void)className; // mantenemos firma, pero no usamos clases
-    std::map<std::string, Method>::iterator it = methods.find(methodName);
-    if (it == methods.end()) {
-        std::cerr << "Metodo " << methodName << " no encontrado\n";
+    Engine::Symbol s = Engine::findSymbol(methodName);
+    if (!methods.find(s)) {
+        LOG_WARN(INTERPRETER, "Metodo " << methodName << " no encontrado");
         return;
     }
+    callMethod(s);
+}
 
-    const std::vector<Command> &body = it->second.commands;
+void ScriptInterpreter::callMethod(Engine::Symbol method) {
+    Method *found = methods.find(method);
+    if (!found) {
+        LOG_WARN(INTERPRETER, "Metodo " << Engine::symbolName(method) << " no encontrado");
+        return;
+    }
+    Method &m = *found;
+    if (m.pending >= 0) compileBinary(m);
+    if (m.body) {
+        Eval::Context cx = context();
+        m.body->run(cx);
+    } else {
+        execute(m.code);
+    }
+}
+
+void ScriptInterpreter::callMethodUncompiled(const std::string &className, const std::string &methodName) {
+    (void)className;
+    const Method *m = findMethod(methodName);
+    if (!m) {
+        LOG_WARN(INTERPRETER, "Metodo " << methodName << " no encontrado");
+        return;
+    }
+
+    const std::vector<Command> &body = m->commands;
     for (size_t i = 0; i < body.size(); ++i) {
         executeCommand(body[i]);
     }
 }
 
 void ScriptInterpreter::runLoop(const std::string &className, const std::string &updateMethodName, int frames, int ms_per_frame) {
-    callMethod(className, "init");
+    (void)className;
+    const Engine::Symbol update = Engine::intern(updateMethodName);
+    callMethod(Engine::intern("init"));
 
-    for (int f = 0; f < frames && !Engine::isGameEnded(); ++f) {
+    // Paso fijo con deadlines absolutos, como runGame en integration_main
+    Engine::FrameScheduler sched(static_cast<long long>(ms_per_frame) * 1000000LL);
+    int f = 0;
+    while (f < frames && !Engine::isGameEnded()) {
         Engine::presentFrame();
-        callMethod(className, updateMethodName);
-#ifdef _WIN32
-        Sleep(ms_per_frame);
-#else
-        usleep(static_cast<useconds_t>(ms_per_frame) * 1000);
-#endif
+        for (int n = sched.advance(); n > 0 && f < frames && !Engine::isGameEnded(); --n, ++f) {
+            callMethod(update);
+        }
+        sched.waitForDeadline();
         if (!Engine::pollEvents()) break;
     }
 
     if (!Engine::isGameEnded()) {
-        callMethod(className, "end");
+        callMethod(Engine::intern("end"));
     }
 }
@@ -1,29 +1,134 @@
 #ifndef SCRIPT_INTERPRETER_H
 #define SCRIPT_INTERPRETER_H
 
+#include "evaluator.h"
+#include "../engine/symbols.h"
+
 #include <string>
 #include <vector>
 #include <map>
 
+namespace Engine { class World; }
+struct BinaryImage;
+
 struct Command {
     std::string name;
     std::vector<std::string> args;
 };
 
+// Códigos de operación del programa compilado (uno por comando del script),
+// en el mismo orden que los símbolos CMD_* de symbols.h
+enum OpCode {
+    OP_SPAWN_BLOCK,
+    OP_MOVE_ENTITY,
+    OP_ROTATE_ENTITY,
+    OP_DROP_ENTITY,
+    OP_ADD_SCORE,
+    OP_SET_SCORE,
+    OP_END_GAME,
+    OP_DRAW_TEXT,
+    OP_UNKNOWN
+};
+
+// OpCode del comando del motor con ese nombre (OP_UNKNOWN si no existe)
+int commandOpcode(const char *name);
+
+// Instrucción ya decodificada: operandos enteros listos y, si el comando
+// lleva texto, el índice de la cadena en la tabla interna del intérprete.
+// En spawnBlock 'c' es el símbolo del tipo (NO_SYMBOL si no es uno del motor).
+struct Instr {
+    int op;
+    int a;
+    int b;
+    int c;
+    int str;
+};
+
+// Los métodos cargados de un .astb no tienen 'commands' (callMethodUncompiled
+// no hace nada con ellos) y su 'code' se arma en la primera llamada. Si el
+// método usa algo más que llamadas (If, While, variables...) se compila a
+// 'body' (un Eval::Body: la máquina de registros o, con SCRIPT_TREE_EVAL,
+// el evaluador de árbol) en lugar de 'code'.
 struct Method {
+    Method() : pending(-1), body(NULL) {}
+    Method(const Method &other);
+    Method& operator=(const Method &other);
+    ~Method();
     std::string name;
     std::vector<Command> commands;
+    std::vector<Instr> code;    // versión compilada de 'commands'
+    int pending;                // nodo Method del .astb aún sin compilar, o -1
+    const Eval::Body *body;     // árbol compilado (compartido entre copias), o NULL
+};
+
+// Métodos del programa en orden de carga, indexados además por el símbolo
+// de su nombre (Engine::intern): buscar uno es indexar un arreglo.
+class MethodTable {
+public:
+    Method& define(const std::string &name);    // vacío; reemplaza al anterior
+    Method* find(Engine::Symbol name);
+    const Method* find(Engine::Symbol name) const;
+
+    size_t size() const { return list_.size(); }
+    bool empty() const { return list_.empty(); }
+    Method& operator[](size_t i) { return list_[i]; }
+    void clear() { list_.clear(); bySymbol_.clear(); }
+
+private:
+    std::vector<Method> list_;
+    std::vector<int> bySymbol_;    // símbolo -> índice en list_, -1 si no hay
 };
 
 class ScriptInterpreter {
 public:
     ScriptInterpreter();
+    ScriptInterpreter(const ScriptInterpreter &other);
+    ScriptInterpreter& operator=(const ScriptInterpreter &other);
+    ~ScriptInterpreter();
+
+    // Carga un .script de texto o, según la extensión, el AST binario
+    // (".astb") o el AST en JSON (".json", solo en builds con SCRIPT_JSON)
     bool loadASTFile(const std::string &path);
+    bool loadBinaryFile(const std::string &path);
+    bool loadJSONFile(const std::string &path);   // script_json.cpp
+    // Compila ya los métodos pendientes de un .astb (p. ej. antes de copiar
+    // el intérprete a cada partida de un lote)
+    void compileAll();
+    // El símbolo se resuelve una vez (Engine::intern) y cada llamada por
+    // símbolo es un acceso al arreglo; la versión con el nombre lo busca en
+    // la tabla global cada vez.
+    void callMethod(Engine::Symbol method);
     void callMethod(const std::string &className, const std::string &methodName);
     void runLoop(const std::string &className, const std::string &updateMethodName = "update", int frames = 200, int ms_per_frame = 16);
+
+    // Ruta textual original (compara nombres y usa atoi en cada llamada).
+    // Se conserva solo como referencia para los benchmarks.
+    void callMethodUncompiled(const std::string &className, const std::string &methodName);
+    // Un método de un .astb que todavía no se llamó aparece con 'code' vacío
+    const Method* findMethod(const std::string &methodName) const;
+
+    // Mundo sobre el que actúan los comandos (por defecto Engine::defaultWorld()).
+    // Un intérprete ya cargado se puede copiar y atar a otro mundo.
+    void bindWorld(Engine::World &w) { world = &w; }
 private:
-    std::map<std::string, Method> methods;
+    Engine::World *world;
+    MethodTable methods;
+    std::vector<std::string> strings;           // tabla de cadenas internadas
+    std::map<std::string, int> stringIndex;
+    BinaryImage *image;                         // .astb mapeado, compartido por las copias
+    std::vector<Eval::Value> slots;             // variables y atributos del programa
+    Eval::Slots slotNames;
+    Eval::RuntimeStrings runtime;               // cadenas armadas al ejecutar
+
     void executeCommand(const Command &cmd);
+    int  internString(const std::string &s);
+    void releaseImage();
+    void resetProgram();
+    Eval::Context context();
+    void compileBinary(Method &m);
+    Instr compileCommand(const Command &cmd);
+    void compileMethod(Method &m);
+    void execute(const std::vector<Instr> &code);
 };
 
 #endif // SCRIPT_INTERPRETER_H
@@ -0,0 +1,148 @@
+// Carga de programas .ast.json (Root -> Class -> Method -> Call) con la
+// interfaz SAX de nlohmann::json: el archivo se mapea y se recorre una vez,
+// y cada Call pasa directo a un Command sin armar el árbol JSON en memoria.
+// Solo se guarda el método que se está leyendo, así la memoria no depende
+// del tamaño del archivo sino de la tabla de métodos que queda al final.
+//
+// json.hpp necesita C++11: este archivo es el único que se compila así
+// (ver JSON en el Makefile); el resto del intérprete sigue en C++98.
+
+#include "script_interpreter.h"
+#include "mapped_file.h"
+#include "../engine/log.h"
+
+#include "json.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Un objeto {"node": ..., "props": {...}, "children": [...]} en lectura.
+// Las claves pueden venir en cualquier orden: se decide al cerrarlo.
+struct NodeFrame {
+    std::string node;
+    std::string name;
+    std::vector<std::string> args;
+    std::vector<Command> calls;     // Call hijos (si es un Method)
+};
+
+class ScriptSax {
+public:
+    using json = nlohmann::json;
+
+    explicit ScriptSax(MethodTable &out) : methods(out) {}
+
+    std::string error;
+
+    bool null()                                  { return value(std::string()); }
+    bool boolean(bool v)                         { return value(v ? "true" : "false"); }
+    bool number_integer(json::number_integer_t v)   { return value(std::to_string(v)); }
+    bool number_unsigned(json::number_unsigned_t v) { return value(std::to_string(v)); }
+    bool number_float(json::number_float_t, const std::string &raw) { return value(raw); }
+    bool string(std::string &v)                  { return value(v); }
+    bool binary(json::binary_t &)                { return value(std::string()); }
+
+    bool key(std::string &k) {
+        lastKey.swap(k);
+        return true;
+    }
+
+    bool start_object(std::size_t) {
+        Scope parent = scopes.empty() ? CHILDREN : scopes.back();
+        if (parent == CHILDREN) {
+            nodes.push_back(NodeFrame());
+            scopes.push_back(NODE);
+        } else if (parent == NODE && lastKey == "props") {
+            scopes.push_back(PROPS);
+        } else {
+            scopes.push_back(OTHER);
+        }
+        return true;
+    }
+
+    bool end_object() {
+        Scope s = scopes.back();
+        scopes.pop_back();
+        if (s != NODE) return true;
+
+        NodeFrame &n = nodes.back();
+        if (n.node == "Call" && nodes.size() >= 2) {
+            NodeFrame &owner = nodes[nodes.size() - 2];
+            owner.calls.push_back(Command());
+            owner.calls.back().name.swap(n.name);
+            owner.calls.back().args.swap(n.args);
+        } else if (n.node == "Method") {
+            Method &m = methods.define(n.name);
+            m.commands.swap(n.calls);
+        }
+        nodes.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t) {
+        Scope parent = scopes.empty() ? OTHER : scopes.back();
+        if (parent == NODE && lastKey == "children") scopes.push_back(CHILDREN);
+        else if (parent == PROPS && lastKey == "args") scopes.push_back(ARGS);
+        else scopes.push_back(OTHER);
+        return true;
+    }
+
+    bool end_array() {
+        scopes.pop_back();
+        return true;
+    }
+
+    bool parse_error(std::size_t pos, const std::string &, const nlohmann::detail::exception &e) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "byte %lu: ", static_cast<unsigned long>(pos));
+        error = buf + std::string(e.what());
+        return false;
+    }
+
+private:
+    // Qué es el contenedor abierto más interno
+    enum Scope { NODE, PROPS, CHILDREN, ARGS, OTHER };
+
+    MethodTable &methods;
+    std::vector<Scope> scopes;
+    std::vector<NodeFrame> nodes;   // nodos abiertos, del más externo al actual
+    std::string lastKey;
+
+    bool value(const std::string &v) {
+        if (scopes.empty()) return true;
+        Scope s = scopes.back();
+        if (s == NODE && lastKey == "node") nodes.back().node = v;
+        else if (s == PROPS && lastKey == "name") nodes.back().name = v;
+        else if (s == ARGS) nodes.back().args.push_back(v);
+        return true;
+    }
+};
+
+} // namespace
+
+bool ScriptInterpreter::loadJSONFile(const std::string &path) {
+    MappedFile file;
+    if (!file.open(path)) {
+        std::cerr << "No se pudo abrir " << path << "\n";
+        return false;
+    }
+
+    resetProgram();
+
+    ScriptSax sax(methods);
+    if (!nlohmann::json::sax_parse(file.data(), file.data() + file.size(), &sax)) {
+        std::cerr << path << ": JSON invalido (" << sax.error << ")\n";
+        methods.clear();
+        return false;
+    }
+
+    for (size_t i = 0; i < methods.size(); ++i) {
+        compileMethod(methods[i]);
+    }
+
+    LOG_INFO(INTERPRETER, "Script cargado (JSON). Metodos: " << methods.size());
+    return !methods.empty();
+}